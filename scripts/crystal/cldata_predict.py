@@ -43,6 +43,7 @@ import xgboost as xgb
 import ast
 import functools
 import crystalcodegen as ccg
+import xgb_to_forest
 try:
     import mlflow
 except ImportError:
@@ -281,6 +282,9 @@ class Learner:
                     name=options.name)
                 booster.save_model(fname)
                 print("==> Saved model to: ", fname)
+                xgb_to_forest.convert(
+                    fname, options.basedir + "/predictor_{name}.forest".format(
+                        name=options.name))
             else:
                 print("WARNING: NOT writing code -- you must use xgboost and give dir for that")
 
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; version 2
+# of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+# 02110-1301, USA.
+
+# Converts a regression model saved by xgboost (booster.save_model() to a
+# .json file) into the text format read by src/treeensemble.cpp
+
+import json
+import argparse
+
+
+def convert(json_fname, forest_fname):
+    with open(json_fname, "r") as f:
+        model = json.load(f)
+
+    learner = model["learner"]
+    booster = learner["gradient_booster"]
+    if booster["name"] != "gbtree":
+        print("ERROR: only 'gbtree' boosters can be converted, this is '%s'"
+              % booster["name"])
+        exit(-1)
+
+    base_score = float(learner["learner_model_param"]["base_score"])
+    trees = booster["model"]["trees"]
+    with open(forest_fname, "w") as f:
+        f.write("forest %d %.9g\n" % (len(trees), base_score))
+        for tree in trees:
+            left = tree["left_children"]
+            right = tree["right_children"]
+            feat = tree["split_indices"]
+            cond = tree["split_conditions"]
+            default_left = tree["default_left"]
+            f.write("tree %d\n" % len(left))
+            for i in range(len(left)):
+                # for leaves, xgboost keeps the leaf value in split_conditions
+                if left[i] == -1:
+                    f.write("-1 -1 0 0 0 %.9g\n" % cond[i])
+                else:
+                    f.write("%d %d %d %.9g %d 0\n" % (
+                        left[i], right[i], feat[i], cond[i],
+                        int(default_left[i])))
+
+    print("==> Converted %d trees to: %s" % (len(trees), forest_fname))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Convert an xgboost JSON model for CryptoMiniSat")
+    parser.add_argument("json", type=str, help="Model saved by xgboost")
+    parser.add_argument("forest", type=str, help="File to write")
+    options = parser.parse_args()
+    convert(options.json, options.forest)
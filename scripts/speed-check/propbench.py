@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Compares two cryptominisat5 binaries on propagation speed, e.g. one built
+# before and one after a change to the watchlists:
+#
+#   ./propbench.py --maxconfl 100000 build-old/cryptominisat5 build/cryptominisat5 a.cnf b.cnf
+#
+# Each binary runs --runs times per file and the fastest run is kept. It
+# prints CPU nanoseconds per propagation and, with --perf, cache misses per
+# propagation as measured by Linux 'perf stat'. The two binaries may take
+# different searches on the same file, so only per-propagation numbers are
+# compared. Use files that are much larger than the last level cache, or
+# the cache misses won't show.
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+EVENTS = ["cache-misses", "L1-dcache-load-misses"]
+
+
+def parse_num(txt):
+    mult = 1
+    if txt[-1] in "KMG":
+        mult = {"K": 1000, "M": 1000*1000, "G": 1000*1000*1000}[txt[-1]]
+        txt = txt[:-1]
+    return float(txt)*mult
+
+
+def run_one(binary, cnf, maxconfl, perf):
+    cmd = [binary, "--maxconfl", str(maxconfl), "--threads", "1",
+           "--printsol", "0", cnf]
+    if perf:
+        cmd = ["perf", "stat", "-x", ",", "-e", ",".join(EVENTS)] + cmd
+    p = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                         universal_newlines=True)
+    out, err = p.communicate()
+    cpu = os.times()
+    cpu = cpu.children_user + cpu.children_system
+
+    props = None
+    for line in out.split("\n"):
+        m = re.match(r"c propagations\s*:\s*([0-9.]+[KMG]?)", line)
+        if m:
+            props = parse_num(m.group(1))
+    if props is None or props == 0:
+        print("ERROR: could not find propagation count for %s %s" % (binary, cnf))
+        sys.exit(-1)
+
+    counters = {}
+    for line in err.split("\n"):
+        parts = line.split(",")
+        if len(parts) >= 3 and parts[2] in EVENTS:
+            try:
+                counters[parts[2]] = float(parts[0])
+            except ValueError:
+                counters[parts[2]] = float("nan")
+
+    return props, cpu, counters
+
+
+def best_of(binary, cnf, maxconfl, perf, runs):
+    best = None
+    for _ in range(runs):
+        before = os.times()
+        before = before.children_user + before.children_system
+        props, after, counters = run_one(binary, cnf, maxconfl, perf)
+        res = (after - before, props, counters)
+        if best is None or res[0] < best[0]:
+            best = res
+    return best
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--maxconfl", type=int, default=100*1000,
+                        help="Number of conflicts to run each solver for")
+    parser.add_argument("--runs", type=int, default=3,
+                        help="Runs per binary and file, the fastest is kept")
+    parser.add_argument("--perf", action="store_true",
+                        help="Also report cache misses via 'perf stat'")
+    parser.add_argument("binaries", nargs=2, help="Baseline and new binary")
+    parser.add_argument("cnfs", nargs="+", help="CNF files to run on")
+    args = parser.parse_args()
+
+    events = EVENTS if args.perf else []
+    print("%-30s %-7s %12s %10s" % ("file", "binary", "props", "ns/prop")
+          + "".join(" %24s" % ("%s/prop" % e) for e in events))
+    for cnf in args.cnfs:
+        res = []
+        for name, binary in zip(("before", "after"), args.binaries):
+            cpu, props, counters = best_of(binary, cnf, args.maxconfl,
+                                           args.perf, args.runs)
+            res.append((cpu, props))
+            print("%-30s %-7s %12d %10.2f" % (cnf[-30:], name, props,
+                                              cpu*1e9/props)
+                  + "".join(" %24.3f" % (counters.get(e, float("nan"))/props)
+                            for e in events))
+        note = ""
+        if res[0][1] != res[1][1]:
+            note = " (different searches)"
+        print("%-30s ns/prop after/before: %.3f%s"
+              % (cnf[-30:], (res[1][0]/res[1][1])/(res[0][0]/res[0][1]), note))
@@ -162,6 +162,7 @@ void BVA::remove_duplicates_from_m_cls()
                     }
                     return false;
                 }
+                case CMSat::watch_shared_t: //Not during simplification
                 case CMSat::watch_idx_t: {
                     // This should never be here
                     assert(false);
@@ -213,6 +214,7 @@ void BVA::remove_duplicates_from_m_cls()
                 break;
             }
 
+            case CMSat::watch_shared_t: //Not during simplification
             case CMSat::watch_idx_t: {
                 // This should never be here
                 assert(false);
@@ -569,6 +571,7 @@ bool BVA::add_longer_clause(const Lit new_lit, const OccurClause& cl)
             break;
         }
 
+        case CMSat::watch_shared_t: //Not during simplification
         case CMSat::watch_idx_t: {
             // This should never be here
             assert(false);
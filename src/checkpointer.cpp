@@ -0,0 +1,89 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "checkpointer.h"
+
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+using namespace CMSat;
+
+Checkpointer::Checkpointer(const string& _fname) :
+    fname(_fname)
+    , running(false)
+{
+}
+
+Checkpointer::~Checkpointer()
+{
+    wait();
+}
+
+void Checkpointer::write_async()
+{
+    wait();
+    running = true;
+    writer = std::thread(&Checkpointer::write_out, this);
+}
+
+bool Checkpointer::wait()
+{
+    if (writer.joinable()) {
+        writer.join();
+    }
+    return error.empty();
+}
+
+void Checkpointer::write_out()
+{
+    const string tmp_fname = fname + ".tmp";
+    error.clear();
+
+    FILE* f = fopen(tmp_fname.c_str(), "wb");
+    if (f == NULL) {
+        error = "cannot open '" + tmp_fname + "': " + strerror(errno);
+        running = false;
+        return;
+    }
+
+    bool ok = fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    ok &= fflush(f) == 0;
+    #if !defined(_WIN32)
+    ok &= fsync(fileno(f)) == 0;
+    #endif
+    ok &= fclose(f) == 0;
+
+    #if defined(_WIN32)
+    //rename() does not replace existing files here
+    remove(fname.c_str());
+    #endif
+    if (!ok || rename(tmp_fname.c_str(), fname.c_str()) != 0) {
+        error = "cannot write '" + tmp_fname + "': " + strerror(errno);
+    } else {
+        num_written++;
+    }
+    running = false;
+}
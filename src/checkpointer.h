@@ -0,0 +1,97 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef CHECKPOINTER_H
+#define CHECKPOINTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CMSat {
+
+using std::string;
+using std::vector;
+
+//Writes solver checkpoints to disk from a background thread. The solver
+//serializes its state into buffer() (in memory, which is quick), then calls
+//write_async() and continues searching while the data is written out.
+//
+//The file is replaced atomically: the data goes to '<fname>.tmp', which is
+//synced and then renamed over '<fname>'. So '<fname>' is always either the
+//previous or the new checkpoint, even if we are killed mid-write.
+class Checkpointer
+{
+public:
+    explicit Checkpointer(const string& fname);
+    ~Checkpointer();
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    //The previous checkpoint is still being written. Don't touch buffer().
+    bool busy() const
+    {
+        return running;
+    }
+
+    vector<char>& buffer()
+    {
+        return buf;
+    }
+
+    void write_async();
+
+    //Waits for the write in progress. Returns false if it failed
+    bool wait();
+
+    const string& get_fname() const
+    {
+        return fname;
+    }
+
+    //Empty if the last write succeeded
+    const string& get_error() const
+    {
+        return error;
+    }
+
+    uint64_t get_num_written() const
+    {
+        return num_written;
+    }
+
+private:
+    void write_out();
+
+    const string fname;
+    vector<char> buf;
+    std::thread writer;
+    std::atomic<bool> running;
+    string error;
+    uint64_t num_written = 0;
+};
+
+}
+
+#endif //CHECKPOINTER_H
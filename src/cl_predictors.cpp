@@ -24,58 +24,31 @@ THE SOFTWARE.
 #include "clause.h"
 #include "solver.h"
 #include <cmath>
-//#define MISSING_VAL std::numeric_limits<float>::quiet_NaN()
-#define MISSING_VAL  -1334556800.0f
+#include <limits>
+#define MISSING_VAL std::numeric_limits<float>::quiet_NaN()
 
 using namespace CMSat;
 
 ClPredictors::ClPredictors(Solver* _solver) :
     solver(_solver)
 {
-    BoosterHandle handle;
-    int ret;
-
-    handles.push_back(handle);
-    ret = XGBoosterCreate(0, 0, &(handles[predict_type::short_pred]));
-    assert(ret == 0);
-    ret = XGBoosterSetParam(handles[predict_type::short_pred], "nthread", "1");
-    assert(ret == 0);
-
-    BoosterHandle handle2;
-    handles.push_back(handle2);
-    ret = XGBoosterCreate(0, 0, &(handles[predict_type::long_pred]));
-    assert(ret == 0);
-    ret = XGBoosterSetParam(handles[predict_type::long_pred], "nthread", "1");
-    assert(ret == 0);
-
-    BoosterHandle handle3;
-    handles.push_back(handle3);
-    ret = XGBoosterCreate(0, 0, &(handles[predict_type::forever_pred]));
-    assert(ret == 0);
-    ret = XGBoosterSetParam(handles[predict_type::forever_pred], "nthread", "1");
-    assert(ret == 0);
-}
-
-ClPredictors::~ClPredictors()
-{
-    for(auto& h: handles) {
-        XGBoosterFree(h);
-    }
 }
 
 void ClPredictors::load_models(const std::string& short_fname,
                                const std::string& long_fname,
                                const std::string& forever_fname)
 {
-    int ret;
-    ret = XGBoosterLoadModel(handles[predict_type::short_pred], short_fname.c_str());
-    assert(ret == 0);
-
-    ret =XGBoosterLoadModel(handles[predict_type::long_pred], long_fname.c_str());
-    assert(ret == 0);
-
-    ret =XGBoosterLoadModel(handles[predict_type::forever_pred], forever_fname.c_str());
-    assert(ret == 0);
+    models[predict_type::short_pred].load(short_fname);
+    models[predict_type::long_pred].load(long_fname);
+    models[predict_type::forever_pred].load(forever_fname);
+    for(const TreeEnsemble& m: models) {
+        if (m.num_features() > PRED_COLS) {
+            std::cerr << "ERROR: predictor model uses feature "
+            << m.num_features()-1 << " but there are only "
+            << PRED_COLS << " features" << std::endl;
+            exit(-1);
+        }
+    }
 }
 
 void ClPredictors::set_up_input(
@@ -367,28 +340,12 @@ void ClPredictors::set_up_input(
     assert(x==cols);
 }
 
-float ClPredictors::predict_one(int num)
+void ClPredictors::clear_rows()
 {
-    bst_ulong out_len;
-    const float *out_result;
-    int ret = XGBoosterPredict(
-        handles[num],
-        dmat,
-        0,  //0: normal prediction
-        0,  //use all trees
-        0,  //do not use for training
-        &out_len,
-        &out_result
-    );
-    assert(ret == 0);
-    assert(out_len == 1);
-
-    float retval = out_result[0];
-    return retval;
+    rows.clear();
 }
 
-float ClPredictors::predict(
-    predict_type pred_type,
+void ClPredictors::add_row(
     const CMSat::Clause* cl,
     const uint64_t sumConflicts,
     const int64_t  last_touched_diff,
@@ -398,7 +355,7 @@ float ClPredictors::predict(
     const double   act_ranking_rel,
     const uint32_t act_ranking_top_10)
 {
-    // convert to DMatrix
+    rows.resize(rows.size()+PRED_COLS);
     set_up_input(
         cl,
         sumConflicts,
@@ -409,57 +366,11 @@ float ClPredictors::predict(
         act_ranking_rel,
         act_ranking_top_10,
         PRED_COLS,
-        train);
-    int rows=1;
-    int ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
-    assert(ret == 0);
-
-    float val = predict_one(pred_type);
-    XGDMatrixFree(dmat);
-
-    return val;
+        rows.data()+rows.size()-PRED_COLS);
 }
 
-void ClPredictors::predict(
-    const CMSat::Clause* cl,
-    const uint64_t sumConflicts,
-    const int64_t  last_touched_diff,
-    #ifdef EXTENDED_FEATURES
-    const int64_t  rdb1_last_touched_diff,
-    #endif
-    const double   act_ranking_rel,
-    const uint32_t act_ranking_top_10,
-    float& p_short,
-    float& p_long,
-    float& p_forever)
+void ClPredictors::predict_rows(predict_type pred_type, vector<float>& out) const
 {
-    // convert to DMatrix
-    set_up_input(
-        cl,
-        sumConflicts,
-        last_touched_diff,
-        #ifdef EXTENDED_FEATURES
-        rdb1_last_touched_diff,
-        #endif
-        act_ranking_rel,
-        act_ranking_top_10,
-        PRED_COLS,
-        train);
-    int rows=1;
-    int ret;
-
-    ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
-    assert(ret == 0);
-    p_short = predict_one(short_pred);
-    XGDMatrixFree(dmat);
-
-    ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
-    assert(ret == 0);
-    p_long = predict_one(long_pred);
-    XGDMatrixFree(dmat);
-
-    ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
-    assert(ret == 0);
-    p_forever = predict_one(forever_pred);
-    XGDMatrixFree(dmat);
+    out.resize(num_rows());
+    models[pred_type].predict(rows.data(), num_rows(), PRED_COLS, out.data());
 }
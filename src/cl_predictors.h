@@ -32,7 +32,7 @@ THE SOFTWARE.
 
 #include <vector>
 #include <string>
-#include <xgboost/c_api.h>
+#include "treeensemble.h"
 
 using std::vector;
 
@@ -43,17 +43,23 @@ enum predict_type {short_pred=0, long_pred=1, forever_pred=2};
 class Solver;
 class Clause;
 
+/**
+@brief Predicts how useful learnt clauses will be, for the predictor-based
+clause cleaning
+
+Clauses are predicted in batches: the features of every clause are added as
+a row, then a model is evaluated over all the rows at once.
+*/
 class ClPredictors
 {
 public:
     ClPredictors(Solver* solver);
-    ~ClPredictors();
     void load_models(const std::string& short_fname,
                      const std::string& long_fname,
                      const std::string& forever_fname);
 
-    float predict(
-        predict_type pred_type,
+    void clear_rows();
+    void add_row(
         const CMSat::Clause* cl,
         const uint64_t sumConflicts,
         const int64_t  last_touched_diff,
@@ -62,22 +68,15 @@ public:
 #endif
         const double   act_ranking_rel,
         const uint32_t act_ranking_top_10);
+    size_t num_rows() const
+    {
+        return rows.size()/PRED_COLS;
+    }
 
-    void predict(
-        const CMSat::Clause* cl,
-        const uint64_t sumConflicts,
-        const int64_t last_touched_diff,
-#ifdef EXTENDED_FEATURES
-        const int64_t rdb1_last_touched_diff,
-#endif
-        const double   act_ranking_rel,
-        const uint32_t act_ranking_top_10,
-        float& p_short,
-        float& p_long,
-        float& p_forever);
+    ///One prediction per row, in the order the rows were added
+    void predict_rows(predict_type pred_type, vector<float>& out) const;
 
 private:
-    float predict_one(int num);
     void set_up_input(
         const CMSat::Clause* cl,
         const uint64_t sumConflicts,
@@ -89,9 +88,8 @@ private:
         const uint32_t act_ranking_top_10,
         const uint32_t cols,
         float* at);
-    vector<BoosterHandle> handles;
-    float train[PRED_COLS];
-    DMatrixHandle dmat;
+    TreeEnsemble models[3];
+    vector<float> rows;
     Solver* solver;
 };
 
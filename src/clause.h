@@ -115,6 +115,7 @@ struct ClauseStats
         ttl = 0;
         which_red_array = 2;
         locked_for_data_gen = 0;
+        is_imported = 0;
         is_decision = false;
         //TODO it's weird, it has been tested to be better with "1"
         activity = 1;
@@ -128,6 +129,7 @@ struct ClauseStats
     uint32_t ttl:2;
     uint32_t which_red_array:3;
     uint32_t locked_for_data_gen:1;
+    uint32_t is_imported:1; //learnt by another thread
     union {
         float   activity;
         uint32_t hash_val; //used in BreakID to remove equivalent clauses
@@ -273,6 +275,7 @@ public:
     uint16_t _xor_is_detached:1;
     uint16_t _gauss_temp_cl:1; ///Used ONLY by Gaussian elimination to incicate where a proagation is coming from
     uint16_t reloced:1;
+    uint16_t prop_uses; ///<Propagations and conflicts since it was last moved, saturating
 
 
     Lit* getData()
@@ -321,6 +324,7 @@ public:
         _used_in_xor_full = false;
         _xor_is_detached = false;
         reloced = false;
+        prop_uses = 0;
 
         for (uint32_t i = 0; i < ps.size(); i++) {
             getData()[i] = ps[i];
@@ -498,6 +502,13 @@ public:
         stats = ClauseStats::combineStats(stats, other);
     }
 
+    void inc_prop_uses()
+    {
+        if (prop_uses != std::numeric_limits<uint16_t>::max()) {
+            prop_uses++;
+        }
+    }
+
     void set_distilled(bool distilled)
     {
         is_distilled = distilled;
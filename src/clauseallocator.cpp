@@ -38,6 +38,11 @@ THE SOFTWARE.
 #include "gaussian.h"
 #endif
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #ifdef USE_VALGRIND
 #include "valgrind/valgrind.h"
 #include "valgrind/memcheck.h"
@@ -61,13 +66,17 @@ using std::endl;
 
 #define MAXSIZE ((1ULL << (EFFECTIVELY_USEABLE_BITS))-1)
 
+//1MB with 32b offsets, 2MB with 64b offsets, 8MB with scaled offsets
+const uint64_t ClauseAllocator::seg_words = 1ULL << 18;
+
 ClauseAllocator::ClauseAllocator() :
     dataStart(NULL)
-    , size(0)
     , capacity(0)
     , currentlyUsedSize(0)
 {
+    std::fill(cur_seg, cur_seg + num_arenas, std::numeric_limits<uint32_t>::max());
     assert(MIN_LIST_SIZE < MAXSIZE);
+    assert(seg_words < MAXSIZE);
 }
 
 /**
@@ -78,41 +87,102 @@ ClauseAllocator::~ClauseAllocator()
     free(dataStart);
 }
 
+uint64_t ClauseAllocator::words_needed(const uint32_t num_lits) const
+{
+    uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
+    return neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+}
+
 void* ClauseAllocator::allocEnough(
     uint32_t num_lits
+    , const uint32_t arena
 ) {
-    //Try to quickly find a place at the end of a dataStart
-    uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
-    uint64_t needed
-        = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+    return alloc_words(words_needed(num_lits), arena);
+}
+
+void* ClauseAllocator::alloc_words(const uint64_t needed, const uint32_t arena)
+{
+    assert(arena < num_arenas);
+    uint32_t& cur = cur_seg[arena];
+
+    //Try to quickly find a place at the end of the arena's current segment
+    if (cur == std::numeric_limits<uint32_t>::max()
+        || segs[cur].used + needed > seg_words
+    ) {
+        if (needed > seg_words) {
+            //Gets a run of segments of its own, current segment is kept
+            const uint32_t num = (needed + seg_words - 1)/seg_words;
+            const uint32_t at = new_segments(num);
+            for(uint32_t i = at; i < at + num; i++) {
+                segs[i].used = seg_words;
+                segs[i].span = 0;
+                segs[i].arena = arena;
+            }
+            segs[at].live = needed;
+            segs[at].span = num;
+            currentlyUsedSize += needed;
+
+            return dataStart + (uint64_t)at*seg_words;
+        }
+
+        if (!free_segs.empty()) {
+            cur = free_segs.back();
+            free_segs.pop_back();
+            segs[cur].free = false;
+        } else {
+            cur = new_segments(1);
+        }
+        segs[cur].arena = arena;
+    }
 
-    if (size + needed > capacity) {
+    //Add clause to the segment
+    Segment& seg = segs[cur];
+    Clause* pointer = (Clause*)(dataStart + (uint64_t)cur*seg_words + seg.used);
+    seg.used += needed;
+    seg.live += needed;
+    currentlyUsedSize += needed;
+
+    return pointer;
+}
+
+uint32_t ClauseAllocator::new_segments(const uint32_t num)
+{
+    const uint64_t at = segs.size();
+    const uint64_t needed = (at + num)*seg_words;
+    if (needed > capacity) {
         //Grow by default, but don't go under or over the limits
         uint64_t newcapacity = capacity * ALLOC_GROW_MULT;
-        newcapacity = std::max<size_t>(newcapacity, MIN_LIST_SIZE);
-        while (newcapacity < size+needed) {
+        newcapacity = std::max<uint64_t>(newcapacity, MIN_LIST_SIZE);
+        while (newcapacity < needed) {
             newcapacity *= ALLOC_GROW_MULT;
         }
-        assert(newcapacity >= size+needed);
-        newcapacity = std::min<size_t>(newcapacity, MAXSIZE);
+        assert(newcapacity >= needed);
+
+        //Always whole segments
+        newcapacity = (newcapacity + seg_words - 1)/seg_words*seg_words;
+        newcapacity = std::min<uint64_t>(newcapacity, MAXSIZE/seg_words*seg_words);
 
         //Oops, not enough space anyway
-        if (newcapacity < size + needed) {
+        if (newcapacity < needed) {
             std::cerr
             << "ERROR: memory manager can't handle the load."
-#ifndef LARGE_OFFSETS
+#if !defined(LARGE_OFFSETS) && !defined(SCALED_OFFSETS)
+            << " **PLEASE RECOMPILE WITH -DSCALEDOFFSETS=ON OR -DLARGEMEM=ON**"
+#elif !defined(LARGE_OFFSETS)
             << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
 #endif
-            << " size: " << size
+            << " size: " << at*seg_words
             << " needed: " << needed
             << " newcapacity: " << newcapacity
             << endl;
             std::cout
             << "ERROR: memory manager can't handle the load."
-#ifndef LARGE_OFFSETS
+#if !defined(LARGE_OFFSETS) && !defined(SCALED_OFFSETS)
+            << " **PLEASE RECOMPILE WITH -DSCALEDOFFSETS=ON OR -DLARGEMEM=ON**"
+#elif !defined(LARGE_OFFSETS)
             << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
 #endif
-            << " size: " << size
+            << " size: " << at*seg_words
             << " needed: " << needed
             << " newcapacity: " << newcapacity
             << endl;
@@ -141,12 +211,38 @@ void* ClauseAllocator::allocEnough(
         capacity = newcapacity;
     }
 
-    //Add clause to the set
-    Clause* pointer = (Clause*)(dataStart + size);
-    size += needed;
-    currentlyUsedSize += needed;
+    segs.resize(at + num);
+    evacuate.resize(segs.size(), 0);
 
-    return pointer;
+    return at;
+}
+
+/**
+@brief Marks the segment (run) as free for reuse and gives its memory back
+
+The pages are zeroed by the OS on the next touch
+*/
+void ClauseAllocator::release_segment(const uint32_t at)
+{
+    const uint32_t span = segs[at].span;
+    assert(span >= 1);
+    currentlyUsedSize -= std::min(currentlyUsedSize, segs[at].live);
+    for(uint32_t i = at; i < at + span; i++) {
+        segs[i] = Segment();
+        segs[i].free = true;
+        free_segs.push_back(i);
+    }
+
+    #if defined(__linux__)
+    static const uintptr_t page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)(dataStart + (uint64_t)at*seg_words);
+    uintptr_t end = start + span*seg_words*sizeof(BASE_DATA_TYPE);
+    start = (start + page - 1)/page*page;
+    end = end/page*page;
+    if (end > start) {
+        madvise((void*)start, end - start, MADV_DONTNEED);
+    }
+    #endif
 }
 
 /**
@@ -165,8 +261,8 @@ ClOffset ClauseAllocator::get_offset(const Clause* ptr) const
 
 If clause was binary, it frees it in quite a normal way. If it isn't, then it
 needs to set the data in the Clause that it has been freed, and updates the
-stack it belongs to such that the stack can now that its effectively used size
-is smaller
+segment it belongs to such that the segment can now that its effectively used
+size is smaller
 
 NOTE: The size of claues can change. Therefore, currentlyUsedSizes can in fact
 be incorrect, since it was incremented by the ORIGINAL size of the clause, but
@@ -182,6 +278,8 @@ void ClauseAllocator::clauseFree(Clause* cl)
     uint64_t bytes_freed = sizeof(Clause) + est_num_cl*sizeof(Lit);
     uint64_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
     currentlyUsedSize -= elems_freed;
+    Segment& seg = segs[get_offset(cl)/seg_words];
+    seg.live -= std::min(seg.live, elems_freed);
 
     #ifdef VALGRIND_MAKE_MEM_UNDEFINED
     VALGRIND_MAKE_MEM_UNDEFINED(((char*)cl)+sizeof(Clause), cl->size()*sizeof(Lit));
@@ -194,69 +292,167 @@ void ClauseAllocator::clauseFree(ClOffset offset)
     clauseFree(cl);
 }
 
-ClOffset ClauseAllocator::move_cl(
-    ClOffset* newDataStart
-    , ClOffset*& new_ptr
-    , Clause* old
-) const {
-    uint64_t bytesNeeded = sizeof(Clause) + old->size()*sizeof(Lit);
-    uint64_t sizeNeeded = bytesNeeded/sizeof(BASE_DATA_TYPE) + (bool)(bytesNeeded % sizeof(BASE_DATA_TYPE));
+/**
+@brief Moves the clause out of a segment being evacuated, returns its new offset
+
+The first time the clause is seen it's copied and its new offset is written
+over its first literal(s). Later references only read that.
+*/
+ClOffset ClauseAllocator::move_cl(const ClOffset offset)
+{
+    Clause* old = ptr(offset);
+    if (old->reloced) {
+        ClOffset new_offset = (*old)[0].toInt();
+        #ifdef LARGE_OFFSETS
+        new_offset += ((uint64_t)(*old)[1].toInt())<<32;
+        #endif
+        return new_offset;
+    }
+
+    const uint64_t sizeNeeded = words_needed(old->size());
+    Clause* new_ptr = (Clause*)alloc_words(sizeNeeded, arena_of(old));
+    old = ptr(offset); //allocation may have moved dataStart
     memcpy(new_ptr, old, sizeNeeded*sizeof(BASE_DATA_TYPE));
 
-    ClOffset new_offset = new_ptr-newDataStart;
+    const ClOffset new_offset = get_offset(new_ptr);
     (*old)[0] = Lit::toLit(new_offset & 0xFFFFFFFF);
     #ifdef LARGE_OFFSETS
     (*old)[1] = Lit::toLit((new_offset>>32) & 0xFFFFFFFF);
     #endif
     old->reloced = true;
 
-    new_ptr += sizeNeeded;
     return new_offset;
 }
 
-void ClauseAllocator::move_one_watchlist(
-    watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr)
+void ClauseAllocator::move_one_watchlist(watch_subarray& ws)
 {
     for(Watched& w: ws) {
-        if (w.isClause()) {
-            Clause* old = ptr(w.get_offset());
-            assert(!old->freed());
-            Lit blocked = w.getBlockedLit();
-            if (old->reloced) {
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                w = Watched(new_offset, blocked);
-            } else {
-                ClOffset new_offset = move_cl(newDataStart, new_ptr, old);
-                w = Watched(new_offset, blocked);
+        if (w.isClause() && is_evacuated(w.get_offset())) {
+            assert(!ptr(w.get_offset())->freed());
+            w.set_offset(move_cl(w.get_offset()));
+        }
+    }
+}
+
+/**
+@brief Moves the evacuated clauses of a redundant tier, most used by propagation first
+
+This way the clauses that propagated or conflicted most since the last
+consolidation end up next to each other. The counts start again afterwards.
+*/
+void ClauseAllocator::move_by_prop_use(vector<ClOffset>& offsets)
+{
+    vector<uint32_t> at;
+    for(uint32_t i = 0; i < offsets.size(); i++) {
+        if (is_evacuated(offsets[i])) {
+            at.push_back(i);
+        }
+    }
+    std::stable_sort(at.begin(), at.end(),
+        [&](const uint32_t a, const uint32_t b) {
+            return ptr(offsets[a])->prop_uses
+                > ptr(offsets[b])->prop_uses;
+    });
+    for(const uint32_t i: at) {
+        offsets[i] = move_cl(offsets[i]);
+    }
+    for(const ClOffset offs: offsets) {
+        ptr(offs)->prop_uses = 0;
+    }
+}
+
+bool ClauseAllocator::is_current_seg(const uint32_t at) const
+{
+    return std::find(cur_seg, cur_seg + num_arenas, at) != cur_seg + num_arenas;
+}
+
+/**
+@brief Size of the redundant clauses in each segment that are of another tier
+
+Clauses are allocated into the arena of their tier, but later they can move
+between the tiers.
+*/
+vector<uint64_t> ClauseAllocator::misplaced_words(const Solver* solver) const
+{
+    vector<uint64_t> misplaced(segs.size(), 0);
+    for(const auto& lredcls: solver->longRedCls) {
+        for(const ClOffset offs: lredcls) {
+            const Clause* cl = ptr(offs);
+            const uint32_t at = offs/seg_words;
+            if (segs[at].span == 1 && segs[at].arena != arena_of(cl)) {
+                misplaced[at] += words_needed(cl->size());
             }
         }
     }
+    return misplaced;
 }
 
 /**
-@brief If needed, compacts stacks, removing unused clauses
+@brief Picks the segments consolidate() should empty, returns their number
 
-Firstly, the algorithm determines if the number of useless slots is large or
-small compared to the problem size. If it is small, it does nothing. If it is
-large, then it allocates new stacks, copies the non-freed clauses to these new
-stacks, updates all pointers and offsets, and frees the original stacks.
+Those that are fragmented or hold mostly clauses of another tier are the
+candidates, the ones cheapest to empty go first. Unless forced, the total
+size of the clauses to move is bounded, so a single call never copies more
+than a fraction of the clause database.
+*/
+size_t ClauseAllocator::select_segments_to_evacuate(
+    const Solver* solver
+    , const bool force
+) {
+    std::fill(evacuate.begin(), evacuate.end(), 0);
+    const vector<uint64_t> misplaced = misplaced_words(solver);
+
+    vector<uint32_t> candidates;
+    for(uint32_t i = 0; i < segs.size(); i++) {
+        const Segment& seg = segs[i];
+        if (seg.free || seg.span == 0 || is_current_seg(i)) {
+            continue;
+        }
+        if (force
+            || float_div(seg.live, seg.span*seg_words) < 0.8
+            || float_div(misplaced[i], seg.live) > 0.5
+        ) {
+            candidates.push_back(i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [&](const uint32_t a, const uint32_t b) {
+            return segs[a].live - std::min(segs[a].live, misplaced[a])
+                < segs[b].live - std::min(segs[b].live, misplaced[b]);
+    });
+
+    const uint64_t budget = std::max<uint64_t>(4*seg_words, currentlyUsedSize/4);
+    uint64_t to_move = 0;
+    size_t num = 0;
+    for(const uint32_t i: candidates) {
+        if (!force && num > 0 && to_move + segs[i].live > budget) {
+            break;
+        }
+        to_move += segs[i].live;
+        evacuate[i] = 1;
+        num++;
+    }
+
+    return num;
+}
+
+/**
+@brief If needed, empties the most fragmented segments
+
+The live clauses of the selected segments are moved to the current (or a
+free, or a new) segment of their arena, all offsets pointing to them are
+updated, and the emptied segments' memory is given back to the OS. Segments
+that are reasonably full are left alone. Redundant clauses are moved first,
+the rest in the order of the watchlists.
 */
 void ClauseAllocator::consolidate(
     Solver* solver
     , const bool force
     , bool lower_verb
 ) {
-    //If re-allocation is not really neccessary, don't do it
-    //Neccesities:
-    //1) There is too much memory allocated. Re-allocation will save space
-    //   Avoiding segfault (max is 16 outerOffsets, more than 10 is near)
-    //2) There is too much empty, unused space (>30%)
-    if (!force
-        && (float_div(currentlyUsedSize, size) > 0.8 || currentlyUsedSize < (100ULL*1000ULL))
-    ) {
+    const size_t num_evac = (force || currentlyUsedSize >= (100ULL*1000ULL)) ?
+        select_segments_to_evacuate(solver, force) : 0;
+    if (num_evac == 0) {
         if (solver->conf.verbosity >= 3
             || (lower_verb && solver->conf.verbosity)
         ) {
@@ -265,70 +461,66 @@ void ClauseAllocator::consolidate(
         return;
     }
     const double myTime = cpuTime();
-
-    //Pointers that will be moved along
-    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)malloc(currentlyUsedSize*sizeof(BASE_DATA_TYPE));
-    BASE_DATA_TYPE * new_ptr = newDataStart;
+    const uint64_t old_mem = mem_used();
 
     assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
-
-    vector<bool> visited(solver->watches.size(), 0);
+    for(auto& lredcls: solver->longRedCls) {
+        move_by_prop_use(lredcls);
+    }
     for(auto& ws: solver->watches) {
-        move_one_watchlist(ws, newDataStart, new_ptr);
+        move_one_watchlist(ws);
     }
 
-    update_offsets(solver->longIrredCls, newDataStart, new_ptr);
+    update_offsets(solver->longIrredCls);
     for(auto& lredcls: solver->longRedCls) {
-        update_offsets(lredcls, newDataStart, new_ptr);
+        update_offsets(lredcls);
     }
-    update_offsets(solver->detached_xor_repr_cls, newDataStart, new_ptr);
+    update_offsets(solver->detached_xor_repr_cls);
 
     //Fix up propBy
     for (size_t i = 0; i < solver->nVars(); i++) {
-        VarData& vdata = solver->varData[i];
-        if (vdata.reason.isClause()) {
-            if (vdata.removed == Removed::none
-                && solver->decisionLevel() >= vdata.level
-                && vdata.level != 0
+        PropBy& reason = solver->varReason[i];
+        if (reason.isClause()) {
+            const uint32_t level = solver->varLevel[i];
+            if (solver->varData[i].removed == Removed::none
+                && solver->decisionLevel() >= level
+                && level != 0
                 && solver->value(i) != l_Undef
             ) {
-                Clause* old = ptr(vdata.reason.get_offset());
-                assert(!old->freed());
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                vdata.reason = PropBy(new_offset);
+                const ClOffset offset = reason.get_offset();
+                if (is_evacuated(offset)) {
+                    assert(!ptr(offset)->freed());
+                    reason = PropBy(move_cl(offset));
+                }
             } else {
-                vdata.reason = PropBy();
+                reason = PropBy();
             }
         }
     }
 
-    //Update sizes
-    const uint64_t old_size = size;
-    size = new_ptr-newDataStart;
-    capacity = currentlyUsedSize;
-    currentlyUsedSize = size;
-    free(dataStart);
-    dataStart = newDataStart;
+    for(uint32_t i = 0; i < evacuate.size(); i++) {
+        if (evacuate[i]) {
+            release_segment(i);
+            evacuate[i] = 0;
+        }
+    }
+    std::sort(free_segs.begin(), free_segs.end(), std::greater<uint32_t>());
 
     const double time_used = cpuTime() - myTime;
     if (solver->conf.verbosity >= 2
         || (lower_verb && solver->conf.verbosity)
     ) {
-        size_t log_2_size = 0;
-        if (size > 0) {
-            //yes, it can be 0 (only binary clauses, for example)
-            log_2_size = std::log2(size);
-        }
         cout << "c [mem] consolidate ";
-        cout << " old-sz: " << print_value_kilo_mega(old_size*sizeof(BASE_DATA_TYPE))
-        << " new-sz: " << print_value_kilo_mega(size*sizeof(BASE_DATA_TYPE))
-        << " new bits offs: " << std::fixed << std::setprecision(2) << log_2_size;
+        cout << " evacuated segs: " << num_evac
+        << " old-sz: " << print_value_kilo_mega(old_mem)
+        << " new-sz: " << print_value_kilo_mega(mem_used())
+        << " free segs: " << free_segs.size() << "/" << segs.size();
         cout << solver->conf.print_times(time_used)
         << endl;
     }
+    if (solver->conf.verbosity >= 3) {
+        print_segment_stats();
+    }
     if (solver->sqlStats) {
         solver->sqlStats->time_passed_min(
             solver
@@ -339,30 +531,65 @@ void ClauseAllocator::consolidate(
 }
 
 void ClauseAllocator::update_offsets(
-    vector<ClOffset>& offsets,
-    ClOffset* newDataStart,
-    ClOffset*& new_ptr
+    vector<ClOffset>& offsets
 ) {
-
     for(ClOffset& offs: offsets) {
+        if (!is_evacuated(offs)) {
+            continue;
+        }
         Clause* old = ptr(offs);
         if (!old->reloced) {
             assert(old->used_in_xor() && old->used_in_xor_full());
             assert(old->_xor_is_detached);
-            offs = move_cl(newDataStart, new_ptr, old);
-        } else {
-            offs = (*old)[0].toInt();
-            #ifdef LARGE_OFFSETS
-            offs += ((uint64_t)(*old)[1].toInt())<<32;
-            #endif
         }
+        offs = move_cl(offs);
     }
 }
 
 size_t ClauseAllocator::mem_used() const
 {
     uint64_t mem = 0;
-    mem += capacity*sizeof(BASE_DATA_TYPE);
+    mem += (segs.size() - free_segs.size())*seg_words*sizeof(BASE_DATA_TYPE);
 
     return mem;
 }
+
+void ClauseAllocator::print_segment_stats() const
+{
+    //How full the segments in use are, in 10% buckets
+    vector<uint64_t> fill(10, 0);
+    vector<uint64_t> per_arena(num_arenas, 0);
+    uint64_t in_use = 0;
+    uint64_t live = 0;
+    for(const Segment& seg: segs) {
+        if (seg.free || seg.span == 0) {
+            continue;
+        }
+        per_arena[seg.arena] += seg.span;
+        const uint64_t room = seg.span*seg_words;
+        in_use += room;
+        live += seg.live;
+        fill[std::min<uint64_t>(9, seg.live*10/room)]++;
+    }
+
+    print_stats_line("c Mem longcl segments"
+        , segs.size() - free_segs.size()
+        , free_segs.size()
+        , "given back"
+    );
+    print_stats_line("c Mem longcl fragmentation"
+        , stats_line_percent(in_use - std::min(in_use, live), in_use)
+        , "%"
+    );
+    cout << "c Mem longcl segments by fill %:";
+    for(size_t i = 0; i < fill.size(); i++) {
+        cout << " " << i*10 << "-" << (i+1)*10 << ": " << fill[i];
+    }
+    cout << endl;
+    cout << "c Mem longcl segments by arena:";
+    for(size_t i = 0; i < per_arena.size(); i++) {
+        cout << " " << (i == irred_arena ? std::string("irred") : "red" + std::to_string(i))
+        << ": " << per_arena[i];
+    }
+    cout << endl;
+}
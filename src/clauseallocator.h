@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <stdlib.h>
 #include <map>
 #include <vector>
+#include <algorithm>
 
 namespace CMSat {
 
@@ -47,27 +48,45 @@ using std::vector;
 @brief Allocates memory for (xor) clauses
 
 This class allocates memory in large chunks, then distributes it to clauses when
-needed. When instructed, it consolidates the unused space (i.e. clauses free()-ed).
-Essentially, it is a stack-like allocator for clauses. It is useful to have
-this, because this way, we can address clauses according to their number,
-which is 32-bit, instead of their address, which might be 64-bit
+needed. It is useful to have this, because this way, we can address clauses
+according to their number, which is 32-bit, instead of their address, which
+might be 64-bit
+
+The chunk is cut into fixed-size segments. Clauses are bump-allocated inside
+the current segment and never straddle two segments (except clauses larger than
+a segment, which get a run of fresh segments of their own). consolidate()
+evacuates only the most fragmented segments: their live clauses are moved
+elsewhere, then the segment's memory is returned to the OS and the segment is
+reused for later allocations. Hence no full copy of the clause database is
+ever needed.
+
+There is a separate current segment, i.e. arena, for each tier of redundant
+clauses and one for the irredundant clauses, so the hot tier-0 and tier-1
+clauses don't get scattered among the cold ones. As clauses change tier,
+consolidate() also evacuates the segments holding mostly clauses of another
+tier, and moves the redundant clauses most used by propagation first.
 */
 class ClauseAllocator {
     public:
         ClauseAllocator();
         ~ClauseAllocator();
 
+        ///Arenas 0..2 are the tiers of redundant clauses
+        static const uint32_t irred_arena = 3;
+        static const uint32_t num_arenas = 4;
+
         template<class T>
         Clause* Clause_new(const T& ps, const uint32_t conflictNum
             #ifdef STATS_NEEDED
             , const int64_t ID
             #endif
+            , const uint32_t arena = irred_arena
         ) {
             if (ps.size() > (0x01UL << 28)) {
                 throw CMSat::TooLongClauseError();
             }
 
-            void* mem = allocEnough(ps.size());
+            void* mem = allocEnough(ps.size(), arena);
             Clause* real = new (mem) Clause(ps, conflictNum
             #ifdef STATS_NEEDED
             , ID
@@ -93,31 +112,54 @@ class ClauseAllocator {
             , bool lower_verb = false
         );
 
+        ///Memory of the segments in use, i.e. excluding those given back
         size_t mem_used() const;
+        void print_segment_stats() const;
 
     private:
-        void update_offsets(
-            vector<ClOffset>& offsets,
-            ClOffset* newDataStart,
-            ClOffset*& new_ptr
-        );
-        void move_one_watchlist(
-            watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr);
-
-        ClOffset move_cl(
-            ClOffset* newDataStart
-            , ClOffset*& new_ptr
-            , Clause* old
-        ) const;
+        struct Segment {
+            uint64_t used = 0; ///<Bump pointer inside the segment
+            /**
+            @brief Estimated size of the non-freed clauses in the segment
+            Clauses can shrink after allocation but are freed at their current
+            size, so this is an overestimation
+            */
+            uint64_t live = 0;
+            /**
+            @brief Number of segments the clauses starting here occupy
+            Normally 1. A clause larger than a segment is given a run of
+            segments: the first has span = run length, the others 0.
+            */
+            uint32_t span = 1;
+            uint32_t arena = irred_arena;
+            bool free = false; ///<Memory given back, waiting for reuse
+        };
+
+        static uint32_t arena_of(const Clause* cl)
+        {
+            if (!cl->red()) {
+                return irred_arena;
+            }
+            return std::min<uint32_t>(cl->stats.which_red_array, irred_arena-1);
+        }
+        uint64_t words_needed(const uint32_t num_lits) const;
+        void* alloc_words(const uint64_t needed, const uint32_t arena);
+        uint32_t new_segments(const uint32_t num);
+        void release_segment(const uint32_t at);
+        bool is_current_seg(const uint32_t at) const;
+        vector<uint64_t> misplaced_words(const Solver* solver) const;
+        size_t select_segments_to_evacuate(const Solver* solver, const bool force);
+
+        bool is_evacuated(const ClOffset offset) const
+        {
+            return evacuate[offset/seg_words];
+        }
+        ClOffset move_cl(const ClOffset offset);
+        void update_offsets(vector<ClOffset>& offsets);
+        void move_by_prop_use(vector<ClOffset>& offsets);
+        void move_one_watchlist(watch_subarray& ws);
 
         BASE_DATA_TYPE* dataStart; ///<Stack starts at these positions
-        uint64_t size; ///<The number of BASE_DATA_TYPE datapieces currently used in each stack
-        /**
-        @brief Clauses in the stack had this size when they were allocated
-        This my NOT be their current size: the clauses may be shrinked during
-        the running of the solver. Therefore, it is imperative that their orignal
-        size is saved. This way, we can later move clauses around.
-        */
         uint64_t capacity; ///<The number of BASE_DATA_TYPE datapieces allocated
         /**
         @brief The estimated used size of the stack
@@ -128,7 +170,13 @@ class ClauseAllocator {
         */
         uint64_t currentlyUsedSize;
 
-        void* allocEnough(const uint32_t num_lits);
+        static const uint64_t seg_words;
+        vector<Segment> segs;
+        vector<uint32_t> free_segs; ///<Kept sorted, lowest index at the back
+        uint32_t cur_seg[num_arenas];
+        vector<char> evacuate; ///<Segments being emptied by consolidate()
+
+        void* allocEnough(const uint32_t num_lits, const uint32_t arena);
 };
 
 } //end namespace
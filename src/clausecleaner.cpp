@@ -90,6 +90,14 @@ void ClauseCleaner::clean_implicit_watchlist(
             continue;
         }
 
+        //Watched literal is set at level 0, so the shared clause is satisfied
+        if (i->isShared()) {
+            if (solver->value(lit) == l_Undef) {
+                *j++ = *i;
+            }
+            continue;
+        }
+
         if (i->isBin()) {
             clean_binary_implicit(*i, j, lit);
             continue;
@@ -132,12 +132,16 @@ void CNF::swapVars(const uint32_t which, const int off_by)
 {
     std::swap(assigns[nVars()-off_by-1], assigns[which]);
     std::swap(varData[nVars()-off_by-1], varData[which]);
+    std::swap(varLevel[nVars()-off_by-1], varLevel[which]);
+    std::swap(varReason[nVars()-off_by-1], varReason[which]);
 }
 
 void CNF::enlarge_nonminimial_datastructs(size_t n)
 {
     assigns.insert(assigns.end(), n, l_Undef);
     varData.insert(varData.end(), n, VarData());
+    varLevel.insert(varLevel.end(), n, 0);
+    varReason.insert(varReason.end(), n, PropBy());
     depth.insert(depth.end(), n, 0);
 }
 
@@ -245,6 +249,8 @@ void CNF::updateVars(
     , const vector<uint32_t>& interToOuter2
 ) {
     updateArray(varData, interToOuter);
+    updateArray(varLevel, interToOuter);
+    updateArray(varReason, interToOuter);
     updateArray(assigns, interToOuter);
     updateBySwap(watches, seen, interToOuter2);
 
@@ -277,6 +283,7 @@ uint64_t CNF::print_mem_used_longclauses(const size_t totalMem) const
         , stats_line_percent(mem, totalMem)
         , "%"
     );
+    cl_alloc.print_segment_stats();
 
     return mem;
 }
@@ -394,16 +401,29 @@ void CNF::save_state(SimpleOutFile& f) const
 
     f.put_vector(assigns);
     f.put_vector(varData);
+    f.put_vector(varLevel);
+    f.put_vector(varReason);
     f.put_uint32_t(minNumVars);
     f.put_uint32_t(num_bva_vars);
     f.put_uint32_t(ok);
+    f.put_uint64_t(sumConflicts);
+
+    f.put_uint64_t(xorclauses.size());
+    for(const Xor& x: xorclauses) {
+        x.save_to_file(f);
+    }
+    f.put_uint64_t(xorclauses_unused.size());
+    for(const Xor& x: xorclauses_unused) {
+        x.save_to_file(f);
+    }
 }
 
+//Loads either into an empty solver, or into one that has just been given
+//all the variables via new_vars() but no clauses (see resume_from_checkpoint)
 void CNF::load_state(SimpleInFile& f)
 {
-    assert(seen.empty());
-    assert(varData.empty());
-    assert(watches.size() == 0);
+    assert(longIrredCls.empty());
+    assert(watches.size() == 0 || watches.size() == assigns.size()*2);
 
     f.get_vector(interToOuterMain);
     f.get_vector(outerToInterMain);
@@ -411,11 +431,25 @@ void CNF::load_state(SimpleInFile& f)
 
     f.get_vector(assigns);
     f.get_vector(varData);
+    f.get_vector(varLevel);
+    f.get_vector(varReason);
     minNumVars = f.get_uint32_t();
     num_bva_vars = f.get_uint32_t();
     ok = f.get_uint32_t();
+    sumConflicts = f.get_uint64_t();
 
-    watches.resize(nVars()*2);
+    xorclauses.resize(f.get_uint64_t());
+    for(Xor& x: xorclauses) {
+        x.load_from_file(f);
+    }
+    xorclauses_unused.resize(f.get_uint64_t());
+    for(Xor& x: xorclauses_unused) {
+        x.load_from_file(f);
+    }
+
+    if (watches.size() == 0) {
+        watches.resize(nVars()*2);
+    }
 }
 
 
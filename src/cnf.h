@@ -124,6 +124,8 @@ public:
     #endif
     uint32_t num_sls_called = 0;
     vector<VarData> varData;
+    vector<uint32_t> varLevel; //decision level at which the assignment was made
+    vector<PropBy> varReason; //reason of the propagation, NULL for decision/toplevel
     branch branch_strategy = branch::vsids;
     string branch_strategy_str = "VSIDSX";
     string branch_strategy_str_short = "vsx";
@@ -382,6 +384,7 @@ void CNF::for_each_lit(
             break;
         }
 
+        case watch_shared_t: //Not during simplification
         case watch_idx_t :
             assert(false);
             break;
@@ -411,6 +414,7 @@ void CNF::for_each_lit_except_watched(
             break;
         }
 
+        case CMSat::watch_shared_t: //Not during simplification
         case CMSat::watch_idx_t:
             assert(false);
             break;
@@ -483,8 +487,8 @@ inline void CNF::clean_occur_from_idx(const Lit lit)
 inline bool CNF::clause_locked(const Clause& c, const ClOffset offset) const
 {
     return value(c[0]) == l_True
-        && varData[c[0].var()].reason.isClause()
-        && varData[c[0].var()].reason.get_offset() == offset;
+        && varReason[c[0].var()].isClause()
+        && varReason[c[0].var()].get_offset() == offset;
 }
 
 inline void CNF::clear_one_occur_from_removed_clauses(watch_subarray w)
@@ -325,7 +325,7 @@ void CompHandler::check_local_vardata_sanity()
         const uint32_t interVar = solver->map_outer_to_inter(outerVar);
         if (savedState[outerVar] != l_Undef) {
             assert(solver->varData[interVar].removed == Removed::decomposed);
-            assert(solver->value(interVar) == l_Undef || solver->varData[interVar].level == 0);
+            assert(solver->value(interVar) == l_Undef || solver->varLevel[interVar] == 0);
         }
 
         if (solver->varData[interVar].removed == Removed::decomposed) {
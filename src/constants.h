@@ -64,6 +64,13 @@ THE SOFTWARE.
 #if defined(LARGE_OFFSETS)
 #define BASE_DATA_TYPE uint64_t
 #define EFFECTIVELY_USEABLE_BITS 62
+#elif defined(SCALED_OFFSETS)
+//Offsets still fit into Watched, but count 32B units: 2^30*32B = 32GB arena
+struct ClauseGranule {
+    uint64_t data[4];
+};
+#define BASE_DATA_TYPE ClauseGranule
+#define EFFECTIVELY_USEABLE_BITS 30
 #else
 #define BASE_DATA_TYPE uint32_t
 #define EFFECTIVELY_USEABLE_BITS 30
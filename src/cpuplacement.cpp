@@ -0,0 +1,154 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "cpuplacement.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace CMSat;
+
+#if defined(__linux__)
+//Format is e.g. "0-3,8-11", used for both CPUs and nodes
+static vector<int> parse_cpulist(const std::string& str)
+{
+    vector<int> ret;
+    std::stringstream ss(str);
+    std::string range;
+    while(std::getline(ss, range, ',')) {
+        int from;
+        int to;
+        const size_t dash = range.find('-');
+        try {
+            from = std::stoi(range.substr(0, dash));
+            to = (dash == std::string::npos) ? from : std::stoi(range.substr(dash+1));
+        } catch (...) {
+            continue;
+        }
+        for(int cpu = from; cpu <= to; cpu++) {
+            ret.push_back(cpu);
+        }
+    }
+    return ret;
+}
+#endif
+
+CPUPlacement::CPUPlacement()
+{
+    #if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool have_allowed =
+        sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string nodes;
+    std::getline(online, nodes);
+    for(const int node: parse_cpulist(nodes)) {
+        std::ifstream f("/sys/devices/system/node/node"
+            + std::to_string(node) + "/cpulist");
+        std::string line;
+        std::getline(f, line);
+        vector<int> cpus;
+        for(const int cpu: parse_cpulist(line)) {
+            if (cpu < CPU_SETSIZE
+                && (!have_allowed || CPU_ISSET(cpu, &allowed))
+            ) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            node_cpus.push_back(cpus);
+        }
+    }
+
+    if (node_cpus.empty()) {
+        vector<int> cpus;
+        for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (have_allowed && CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            node_cpus.push_back(cpus);
+        }
+    }
+    #endif
+
+    if (node_cpus.empty()) {
+        vector<int> cpus;
+        const int n = std::max<int>(1, std::thread::hardware_concurrency());
+        for(int cpu = 0; cpu < n; cpu++) {
+            cpus.push_back(cpu);
+        }
+        node_cpus.push_back(cpus);
+    }
+}
+
+int CPUPlacement::cpu_for_thread(const uint32_t tid) const
+{
+    const vector<int>& cpus = node_cpus[tid % node_cpus.size()];
+    return cpus[(tid / node_cpus.size()) % cpus.size()];
+}
+
+int CPUPlacement::node_of_cpu(const int cpu) const
+{
+    for(size_t node = 0; node < node_cpus.size(); node++) {
+        const vector<int>& cpus = node_cpus[node];
+        if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) {
+            return node;
+        }
+    }
+    return -1;
+}
+
+bool CPUPlacement::pin_this_thread(const int cpu)
+{
+    #if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    #else
+    (void)cpu;
+    return false;
+    #endif
+}
+
+int CPUPlacement::current_cpu()
+{
+    #if defined(__linux__)
+    return sched_getcpu();
+    #else
+    return -1;
+    #endif
+}
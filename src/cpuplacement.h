@@ -0,0 +1,68 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef CPU_PLACEMENT_H
+#define CPU_PLACEMENT_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+using std::vector;
+
+namespace CMSat {
+
+/**
+@brief The CPUs this process may run on, grouped by NUMA node
+
+Only Linux is supported: elsewhere, or when sysfs can't be read, all CPUs
+are on node 0 and pin_this_thread() does nothing.
+
+There is no need to allocate memory on a given node explicitly: a thread
+pinned before it allocates gets its memory on its own node, as Linux
+allocates on the node of the CPU that first touches a page.
+*/
+class CPUPlacement
+{
+    public:
+        CPUPlacement();
+
+        ///Consecutive threads go to different nodes, then different CPUs
+        int cpu_for_thread(const uint32_t tid) const;
+        int node_of_cpu(const int cpu) const;
+        size_t num_nodes() const
+        {
+            return node_cpus.size();
+        }
+
+        ///Returns false if it's not supported or failed
+        static bool pin_this_thread(const int cpu);
+
+        ///-1 if not known
+        static int current_cpu();
+
+    private:
+        vector<vector<int> > node_cpus;
+};
+
+}
+
+#endif //CPU_PLACEMENT_H
@@ -25,7 +25,13 @@ THE SOFTWARE.
 #include "solver.h"
 #include "drat.h"
 #include "shareddata.h"
+#include "sharedclausedb.h"
+#include "cubefinder.h"
+#include "externalcallbacks.h"
+#include "cpuplacement.h"
 #include <fstream>
+#include <algorithm>
+#include <chrono>
 
 #include <thread>
 #include <mutex>
@@ -65,13 +71,20 @@ namespace CMSat {
 
             delete log; //this will also close the file
             delete shared_data;
+            delete shared_cls_db;
+            delete cpu_placement;
         }
         CMSatPrivateData(const CMSatPrivateData&) = delete;
         CMSatPrivateData& operator=(const CMSatPrivateData&) = delete;
 
         vector<Solver*> solvers;
         SharedData *shared_data = NULL;
+        SharedClauseDB *shared_cls_db = NULL;
+        CPUPlacement *cpu_placement = NULL; ///<only made when pinning threads
+        ExternalCallbacks callbacks;
         int which_solved = 0;
+        vector<Lit> cubes_conflict; ///<get_conflict() when all cubes were refuted
+        bool conflict_from_cubes = false;
         std::atomic<bool>* must_interrupt;
         bool must_interrupt_needs_delete = false;
         bool okay = true;
@@ -108,7 +121,17 @@ struct DataForThread
         , update_mutex(new std::mutex)
         , which_solved(&(data->which_solved))
         , ret(new lbool(l_Undef))
+        , ran_on_cpu(data->solvers.size(), -1)
+        , wall_times(data->solvers.size(), 0)
     {
+        if (data->solvers[0]->conf.pin_threads) {
+            if (data->cpu_placement == NULL) {
+                data->cpu_placement = new CPUPlacement;
+            }
+            for(size_t i = 0; i < data->solvers.size(); i++) {
+                cpus.push_back(data->cpu_placement->cpu_for_thread(i));
+            }
+        }
     }
 
     ~DataForThread()
@@ -124,8 +147,21 @@ struct DataForThread
     std::mutex* update_mutex;
     int *which_solved;
     lbool* ret;
+
+    vector<int> cpus; ///<CPU to pin each thread to, empty if not pinning
+    vector<int> ran_on_cpu;
+    vector<double> wall_times;
 };
 
+//Pinned before it allocates anything, a thread's clauses and watches
+//will be on its own NUMA node
+static void pin_thread(const DataForThread& data_for_thread, const size_t tid)
+{
+    if (!data_for_thread.cpus.empty()) {
+        CPUPlacement::pin_this_thread(data_for_thread.cpus[tid]);
+    }
+}
+
 DLL_PUBLIC SATSolver::SATSolver(
     void* config
     , std::atomic<bool>* interrupt_asap
@@ -141,6 +177,7 @@ DLL_PUBLIC SATSolver::SATSolver(
     }
 
     data->solvers.push_back(new Solver((SolverConf*) config, data->must_interrupt));
+    data->solvers.back()->set_external_callbacks(&data->callbacks);
     data->cpu_times.push_back(0.0);
 }
 
@@ -154,6 +191,10 @@ void update_config(SolverConf& conf, unsigned thread_num)
     //Don't accidentally reconfigure everything to a specific value!
     if (thread_num > 0) {
         conf.reconfigure_val = 0;
+
+        //Only the first thread checkpoints
+        conf.checkpoint_file.clear();
+        conf.resume_from_checkpoint = false;
     }
     conf.origSeed += thread_num;
     conf.thread_num = thread_num;
@@ -366,6 +407,57 @@ void update_config(SolverConf& conf, unsigned thread_num)
     }
 }
 
+//The Solver::reconfigure() value closest to what update_config() sets up
+//for the thread, 0 if none is. The Portfolio starts from these
+static int reconf_val_like(const unsigned thread_num)
+{
+    switch(thread_num % 23) {
+        case 1:
+        case 13:
+            return 15; //Minisat-like
+        case 3:
+        case 15:
+            return 3; //Glue clause cleaning
+        case 4:
+        case 16:
+        case 18:
+            return 4;
+        case 5:
+            return 6; //No more simplifying
+        case 7:
+            return 12;
+        case 19:
+        case 22:
+            return 13;
+        default:
+            return 0;
+    }
+}
+
+//All threads but the first one watch the long irred clauses stored once in
+//shared_cls_db. They can't simplify, as they don't own these clauses. The
+//first thread keeps a private copy so that it can simplify, so the clauses
+//are stored twice in total instead of once per thread. Opt-in, see
+//SolverConf::share_irred_db
+static void setup_shared_cls_db(CMSatPrivateData* data)
+{
+    if (data->solvers.size() == 1 || data->shared_cls_db != NULL) {
+        return;
+    }
+
+    data->shared_cls_db = new SharedClauseDB;
+    for(size_t i = 1; i < data->solvers.size(); i++) {
+        Solver& s = *data->solvers[i];
+        s.conf.doRenumberVars = false;
+        s.conf.simplify_at_startup = false;
+        s.conf.simplify_at_every_startup = false;
+        s.conf.full_simplify_at_startup = false;
+        s.conf.perform_occur_based_simp = false;
+        s.conf.do_simplify_problem = false;
+        s.set_shared_cls_db(data->shared_cls_db);
+    }
+}
+
 DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
 {
     if (num <= 0) {
@@ -392,15 +484,21 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
     }
 
     data->cls_lits.reserve(CACHE_SIZE);
+    const SolverConf base_conf = data->solvers[0]->getConf();
     for(unsigned i = 1; i < num; i++) {
-        SolverConf conf = data->solvers[0]->getConf();
+        SolverConf conf = base_conf;
         update_config(conf, i);
         data->solvers.push_back(new Solver(&conf, data->must_interrupt));
+        data->solvers.back()->set_external_callbacks(&data->callbacks);
+        data->solvers.back()->set_portfolio_base_conf(base_conf);
         data->cpu_times.push_back(0.0);
     }
 
     //set shared data
     data->shared_data = new SharedData(data->solvers.size());
+    for(unsigned i = 0; i < num; i++) {
+        data->shared_data->portfolio.set_initial_conf(i, reconf_val_like(i));
+    }
     for(unsigned i = 0; i < num; i++) {
         SolverConf conf = data->solvers[i]->getConf();
         if (i >= 1) {
@@ -410,6 +508,24 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
         data->solvers[i]->setConf(conf);
         data->solvers[i]->set_shared_data((SharedData*)data->shared_data);
     }
+
+    if (data->solvers[0]->conf.share_irred_db) {
+        setup_shared_cls_db(data);
+    }
+}
+
+DLL_PUBLIC void SATSolver::set_share_irred_clauses()
+{
+    if (data->cls > 0 || nVars() > 0) {
+        const char err[] = "ERROR: You must first call set_share_irred_clauses() and only then add clauses and variables";
+        std::cerr << err << endl;
+        throw std::runtime_error(err);
+    }
+
+    for (Solver* s: data->solvers) {
+        s->conf.share_irred_db = 1;
+    }
+    setup_shared_cls_db(data);
 }
 
 struct OneThreadAddCls
@@ -422,6 +538,7 @@ struct OneThreadAddCls
 
     void operator()()
     {
+        pin_thread(data_for_thread, tid);
         Solver& solver = *data_for_thread.solvers[tid];
         solver.new_external_vars(data_for_thread.vars_to_add);
 
@@ -459,6 +576,10 @@ struct OneThreadAddCls
             }
         }
 
+        if (ret && solver.shared_cls_db != NULL) {
+            ret = solver.attach_shared_clauses();
+        }
+
         if (!ret) {
             data_for_thread.update_mutex->lock();
             *data_for_thread.ret = l_False;
@@ -470,8 +591,36 @@ struct OneThreadAddCls
     const size_t tid;
 };
 
+//Fills the SharedClauseDB before the threads read it
+static void add_to_shared_cls_db(CMSatPrivateData* data)
+{
+    vector<Lit> lits;
+    const vector<Lit>& orig_lits = data->cls_lits;
+    size_t at = 0;
+    while(at < orig_lits.size()) {
+        //xor clauses are not shared
+        const bool is_xor = orig_lits[at] == lit_Error;
+        at += is_xor ? 2 : 1;
+        lits.clear();
+        for(; at < orig_lits.size()
+            && orig_lits[at] != lit_Undef
+            && orig_lits[at] != lit_Error
+            ; at++
+        ) {
+            lits.push_back(orig_lits[at]);
+        }
+        if (!is_xor && SharedClauseDB::normalise(lits)) {
+            data->shared_cls_db->add(lits);
+        }
+    }
+}
+
 static bool actually_add_clauses_to_threads(CMSatPrivateData* data)
 {
+    if (data->shared_cls_db) {
+        add_to_shared_cls_db(data);
+    }
+
     DataForThread data_for_thread(data);
     if (data->solvers.size() == 1) {
         OneThreadAddCls t(data_for_thread, 0);
@@ -485,7 +634,7 @@ static bool actually_add_clauses_to_threads(CMSatPrivateData* data)
             thread.join();
         }
     }
-    bool ret = (*data_for_thread.ret == l_True);
+    bool ret = (*data_for_thread.ret != l_False);
 
     //clear what has been added
     data->cls_lits.clear();
@@ -653,6 +802,80 @@ DLL_PUBLIC bool SATSolver::add_clause(const vector< Lit >& lits)
     return ret;
 }
 
+DLL_PUBLIC bool SATSolver::add_clauses(const int* lits, size_t num_lits)
+{
+    //Checked before anything negates or converts them: -INT_MIN overflows
+    const int64_t num_vars = nVars();
+    for(size_t i = 0; i < num_lits; i++) {
+        if ((int64_t)lits[i] > num_vars || (int64_t)lits[i] < -num_vars) {
+            std::stringstream ss;
+            ss << "ERROR: add_clauses() got literal " << lits[i]
+            << " but there are only " << num_vars << " variables";
+            std::cerr << ss.str() << endl;
+            throw std::runtime_error(ss.str());
+        }
+    }
+
+    if (data->log) {
+        for(size_t i = 0; i < num_lits; i++) {
+            (*data->log) << lits[i] << (lits[i] == 0 ? "\n" : " ");
+        }
+        (*data->log) << std::flush;
+    }
+
+    //Every thread reads the caller's buffer directly, no intermediate copy
+    bool ret = true;
+    if (data->solvers.size() > 1) {
+        if (!data->cls_lits.empty() || data->vars_to_add > 0) {
+            ret = actually_add_clauses_to_threads(data);
+        }
+
+        if (data->shared_cls_db) {
+            vector<Lit> cl;
+            for(const int* l = lits, *end = lits + num_lits; l != end; l++) {
+                if (*l != 0) {
+                    cl.push_back(Lit(*l > 0 ? *l-1 : -(*l+1), *l < 0));
+                    continue;
+                }
+                if (SharedClauseDB::normalise(cl)) {
+                    data->shared_cls_db->add(cl);
+                }
+                cl.clear();
+            }
+            if (SharedClauseDB::normalise(cl)) {
+                data->shared_cls_db->add(cl);
+            }
+        }
+
+        DataForThread data_for_thread(data);
+        vector<char> rets(data->solvers.size(), true);
+        std::vector<std::thread> thds;
+        for(size_t i = 0; i < data->solvers.size(); i++) {
+            Solver* s = data->solvers[i];
+            char* r = &rets[i];
+            thds.push_back(thread([=, &data_for_thread]() {
+                pin_thread(data_for_thread, i);
+                *r = s->add_clauses_outer(lits, num_lits)
+                    && (s->shared_cls_db == NULL || s->attach_shared_clauses());
+            }));
+        }
+        for(std::thread& thread : thds){
+            thread.join();
+        }
+        for(const char r: rets) {
+            ret &= (bool)r;
+        }
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+
+        ret = data->solvers[0]->add_clauses_outer(lits, num_lits);
+    }
+    data->cls += std::count(lits, lits + num_lits, 0);
+
+    return ret;
+}
+
 void add_xor_clause_to_log(const std::vector<unsigned>& vars, bool rhs, std::ofstream* file)
 {
     if (vars.size() == 0) {
@@ -714,6 +937,8 @@ struct OneThreadCalc
 
     void operator()()
     {
+        pin_thread(data_for_thread, tid);
+        const auto wall_start = std::chrono::steady_clock::now();
         if (print_thread_start_and_finish) {
             start_time = cpuTime();
             //data_for_thread.update_mutex->lock();
@@ -731,6 +956,9 @@ struct OneThreadCalc
         }
 
         data_for_thread.cpu_times[tid] = cpuTime();
+        data_for_thread.ran_on_cpu[tid] = CPUPlacement::current_cpu();
+        data_for_thread.wall_times[tid] = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - wall_start).count();
         if (print_thread_start_and_finish) {
             data_for_thread.update_mutex->lock();
             ios::fmtflags f(cout.flags());
@@ -760,6 +988,30 @@ struct OneThreadCalc
     bool only_sampling_solution;
 };
 
+static void print_thread_throughput(
+    const CMSatPrivateData* data
+    , const DataForThread& data_for_thread
+    , const vector<uint64_t>& confl_before
+    , const vector<uint64_t>& props_before
+) {
+    ios::fmtflags f(cout.flags());
+    for(size_t i = 0; i < data->solvers.size(); i++) {
+        const Solver& s = *data->solvers[i];
+        const int cpu = data_for_thread.ran_on_cpu[i];
+        const double t = data_for_thread.wall_times[i];
+        cout << "c [thread " << i << "]"
+        << " cpu: " << cpu
+        << " node: " << (data->cpu_placement ? data->cpu_placement->node_of_cpu(cpu) : -1)
+        << " confl/s: " << std::fixed << std::setprecision(0)
+        << float_div(s.sumConflicts - confl_before[i], t)
+        << " Mprops/s: " << std::setprecision(2)
+        << float_div(s.sumPropStats.propagations - props_before[i], t*1000.0*1000.0)
+        << " T-wall: " << t
+        << endl;
+    }
+    cout.flags(f);
+}
+
 lbool calc(
     const vector< Lit >* assumptions,
     bool solve, CMSatPrivateData *data,
@@ -767,6 +1019,7 @@ lbool calc(
 ) {
     //Reset the interrupt signal if it was set
     data->must_interrupt->store(false, std::memory_order_relaxed);
+    data->conflict_from_cubes = false;
 
     //Set timeout information
     if (data->timeout != std::numeric_limits<double>::max()) {
@@ -809,7 +1062,16 @@ lbool calc(
     }
 
     //Multi-thread from now on.
+    if (data->shared_cls_db) {
+        add_to_shared_cls_db(data);
+    }
     DataForThread data_for_thread(data, assumptions);
+    vector<uint64_t> confl_before;
+    vector<uint64_t> props_before;
+    for(const Solver* s: data->solvers) {
+        confl_before.push_back(s->sumConflicts);
+        props_before.push_back(s->sumPropStats.propagations);
+    }
     std::vector<std::thread> thds;
     for(size_t i = 0
         ; i < data->solvers.size()
@@ -821,6 +1083,11 @@ lbool calc(
         thread.join();
     }
     lbool real_ret = *data_for_thread.ret;
+    if (data->solvers[0]->conf.verbosity >= 2
+        || (data->solvers[0]->conf.verbosity && data->solvers[0]->conf.pin_threads)
+    ) {
+        print_thread_throughput(data, data_for_thread, confl_before, props_before);
+    }
 
     //This does it for all of them, there is only one must-interrupt
     data_for_thread.solvers[0]->unset_must_interrupt_asap();
@@ -853,6 +1120,247 @@ DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions, bool only_sa
     return calc(assumptions, true, data, only_sampling_solution);
 }
 
+struct CubeWork
+{
+    CubeWork(const size_t num_threads, const vector<Lit>* _assumptions) :
+        assumptions(_assumptions)
+        , solved(num_threads, 0)
+        , cpu_time(num_threads, 0)
+        , conflict(num_threads)
+    {}
+
+    vector<vector<Lit>> cubes;
+    const vector<Lit>* assumptions;
+    std::atomic<size_t> next_cube{0};
+    std::atomic<bool> aborted{false};
+
+    //Indexed by thread, each thread only writes its own
+    vector<uint64_t> solved;
+    vector<double> cpu_time;
+
+    //The negated user assumptions in the final conflicts of refuted cubes
+    vector<vector<Lit>> conflict;
+};
+
+//Takes the next unsolved cube until all are gone. Learnt clauses are kept
+//in the thread's solver from one cube to the next.
+struct OneThreadCube
+{
+    OneThreadCube(
+        DataForThread& _data_for_thread,
+        CubeWork& _work,
+        size_t _tid
+    ) :
+        data_for_thread(_data_for_thread)
+        , work(_work)
+        , tid(_tid)
+    {}
+
+    void operator()()
+    {
+        pin_thread(data_for_thread, tid);
+        Solver& solver = *data_for_thread.solvers[tid];
+
+        //solve_with_assumptions() resets these after every call
+        const long max_confl = solver.conf.max_confl;
+        const double max_time = solver.conf.maxTime;
+        const unsigned verbosity = solver.conf.verbosity;
+        if (verbosity < 2) {
+            solver.conf.verbosity = 0;
+        }
+
+        //The cubes are found without the assumptions, so together they cover
+        //everything the assumptions allow. 1: assumption, 2: also in conflict
+        vector<char> is_assump(2*solver.nVarsOutside(), 0);
+        if (work.assumptions) {
+            for(const Lit lit: *work.assumptions) {
+                is_assump[lit.toInt()] = 1;
+            }
+        }
+
+        vector<Lit> assumps;
+        lbool ret = l_False;
+        while(!solver.must_interrupt_asap()) {
+            const size_t at = work.next_cube.fetch_add(1);
+            if (at >= work.cubes.size()) {
+                break;
+            }
+
+            assumps.clear();
+            if (work.assumptions) {
+                assumps = *work.assumptions;
+            }
+            const vector<Lit>& cube = work.cubes[at];
+            assumps.insert(assumps.end(), cube.begin(), cube.end());
+
+            solver.conf.max_confl = max_confl;
+            solver.conf.maxTime = max_time;
+            const double start_time = cpuTime();
+            ret = solver.solve_with_assumptions(&assumps, false);
+            work.cpu_time[tid] += cpuTime() - start_time;
+            work.solved[tid]++;
+
+            //UNSAT only under this cube, go to the next one
+            if (ret == l_False && solver.okay()) {
+                for(const Lit lit: solver.get_final_conflict()) {
+                    if (is_assump[(~lit).toInt()] == 1) {
+                        is_assump[(~lit).toInt()] = 2;
+                        work.conflict[tid].push_back(lit);
+                    }
+                }
+                continue;
+            }
+            break;
+        }
+        solver.conf.verbosity = verbosity;
+        data_for_thread.cpu_times[tid] = cpuTime();
+
+        if (ret == l_True || (ret == l_False && !solver.okay())) {
+            data_for_thread.update_mutex->lock();
+            if (*data_for_thread.ret == l_Undef) {
+                *data_for_thread.which_solved = tid;
+                *data_for_thread.ret = ret;
+            }
+            //will interrupt all of them
+            data_for_thread.solvers[0]->set_must_interrupt_asap();
+            data_for_thread.update_mutex->unlock();
+        } else if (ret == l_Undef || solver.must_interrupt_asap()) {
+            //The cubes this thread didn't get to are unsolved, so the others
+            //can't decide the formula either
+            work.aborted = true;
+            data_for_thread.solvers[0]->set_must_interrupt_asap();
+        }
+    }
+
+    DataForThread& data_for_thread;
+    CubeWork& work;
+    const size_t tid;
+};
+
+//The formula itself is UNSAT: the conflict is empty, and every solver
+//agrees, as if the empty clause had been added
+static lbool cubes_formula_unsat(CMSatPrivateData* data)
+{
+    for(Solver* s: data->solvers) {
+        s->ok = false;
+    }
+    data->okay = false;
+    data->which_solved = 0;
+    data->cubes_conflict.clear();
+    data->conflict_from_cubes = true;
+    return l_False;
+}
+
+DLL_PUBLIC lbool SATSolver::solve_cubes(unsigned cube_depth, const vector< Lit >* assumptions)
+{
+    if (data->promised_single_call) {
+        cout
+        << "ERROR: solve_cubes() solves every cube with a separate solve() call"
+        << "       and cannot be used after set_single_run(). Exiting."
+        << endl;
+        exit(-1);
+    }
+    data->num_solve_simplify_calls++;
+
+    //set information data (props, confl, dec)
+    data->previous_sum_conflicts = get_sum_conflicts();
+    data->previous_sum_propagations = get_sum_propagations();
+    data->previous_sum_decisions = get_sum_decisions();
+    data->must_interrupt->store(false, std::memory_order_relaxed);
+    data->conflict_from_cubes = false;
+    if (data->timeout != std::numeric_limits<double>::max()) {
+        for (Solver* s: data->solvers) {
+            s->conf.maxTime = cpuTime() + data->timeout;
+        }
+    }
+
+    if (data->log) {
+        (*data->log) << "c Solver::solve_cubes( " << cube_depth << ", ";
+        if (assumptions) {
+            (*data->log) << *assumptions;
+        }
+        (*data->log) << " )" << endl;
+    }
+
+    if (data->solvers.size() > 1) {
+        actually_add_clauses_to_threads(data);
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+    }
+    for(Solver* s: data->solvers) {
+        if (!s->okay()) {
+            return cubes_formula_unsat(data);
+        }
+    }
+
+    const unsigned verbosity = data->solvers[0]->conf.verbosity;
+    CubeWork work(data->solvers.size(), assumptions);
+    CubeFinder finder(data->solvers[0]);
+    if (!finder.find_cubes(cube_depth, work.cubes)) {
+        //Every branch was refuted by propagation, without the assumptions
+        if (verbosity) {
+            finder.get_stats().print();
+        }
+        return cubes_formula_unsat(data);
+    }
+
+    DataForThread data_for_thread(data, assumptions);
+    if (data->solvers.size() == 1) {
+        OneThreadCube t(data_for_thread, work, 0);
+        t.operator()();
+    } else {
+        std::vector<std::thread> thds;
+        for(size_t i = 0; i < data->solvers.size(); i++) {
+            thds.push_back(thread(OneThreadCube(data_for_thread, work, i)));
+        }
+        for(std::thread& thread : thds){
+            thread.join();
+        }
+    }
+    data_for_thread.solvers[0]->unset_must_interrupt_asap();
+
+    lbool ret = *data_for_thread.ret;
+    if (ret == l_Undef && !work.aborted) {
+        //Every cube has been refuted. The final conflict of any one solver
+        //also has cube literals, so it's built from all of them instead
+        ret = l_False;
+        data->which_solved = 0;
+        data->cubes_conflict.clear();
+        vector<char> in_confl(2*data->solvers[0]->nVarsOutside(), 0);
+        for(const vector<Lit>& confl: work.conflict) {
+            for(const Lit lit: confl) {
+                if (!in_confl[lit.toInt()]) {
+                    in_confl[lit.toInt()] = 1;
+                    data->cubes_conflict.push_back(lit);
+                }
+            }
+        }
+        data->conflict_from_cubes = true;
+    }
+    if (ret == l_False
+        && (!data->solvers[data->which_solved]->okay() || get_conflict().empty())
+    ) {
+        //No assumption was needed to refute it
+        cubes_formula_unsat(data);
+    }
+
+    if (verbosity) {
+        finder.get_stats().print();
+        for(size_t i = 0; i < data->solvers.size(); i++) {
+            std::stringstream ss;
+            ss << "c cubes solved by thread " << i;
+            print_stats_line(ss.str()
+                , work.solved[i]
+                , float_div(work.cpu_time[i], work.solved[i])
+                , "s/cube"
+            );
+        }
+    }
+
+    return ret;
+}
+
 DLL_PUBLIC lbool SATSolver::simplify(const vector< Lit >* assumptions)
 {
     if (data->promised_single_call
@@ -881,6 +1389,9 @@ DLL_PUBLIC const vector< lbool >& SATSolver::get_model() const
 
 DLL_PUBLIC const std::vector<Lit>& SATSolver::get_conflict() const
 {
+    if (data->conflict_from_cubes) {
+        return data->cubes_conflict;
+    }
 
     return data->solvers[data->which_solved]->get_final_conflict();
 }
@@ -1015,6 +1526,21 @@ DLL_PUBLIC void SATSolver::interrupt_asap()
     data->must_interrupt->store(true, std::memory_order_relaxed);
 }
 
+DLL_PUBLIC void SATSolver::set_terminate_callback(
+    int (*terminate)(void* state), void* state)
+{
+    data->callbacks.terminate = terminate;
+    data->callbacks.terminate_state = state;
+}
+
+DLL_PUBLIC void SATSolver::set_learn_callback(
+    void (*learn)(void* state, int* clause), void* state, int max_length)
+{
+    data->callbacks.learn = learn;
+    data->callbacks.learn_state = state;
+    data->callbacks.learn_max_len = (learn == NULL || max_length < 0) ? 0 : max_length;
+}
+
 void DLL_PUBLIC SATSolver::add_in_partial_solving_stats()
 {
     data->solvers[data->which_solved]->add_in_partial_solving_stats();
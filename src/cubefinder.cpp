@@ -0,0 +1,201 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "cubefinder.h"
+#include "solver.h"
+#include "time_mem.h"
+
+#include <algorithm>
+
+using namespace CMSat;
+
+CubeFinder::CubeFinder(Solver* _solver) :
+    solver(_solver)
+{
+}
+
+bool CubeFinder::find_cubes(const uint32_t depth, vector<vector<Lit>>& _cubes)
+{
+    assert(solver->okay());
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    const uint64_t orig_cubes = stats.cubes;
+    const uint64_t orig_refuted = stats.refuted;
+
+    cubes = &_cubes;
+    cubes->clear();
+    cube.clear();
+    outer_to_without_bva = solver->build_outer_to_without_bva_map();
+    pick_candidates();
+    split(depth);
+    assert(solver->decisionLevel() == 0);
+    cubes = NULL;
+
+    const double time_used = cpuTime() - myTime;
+    stats.cpu_time += time_used;
+    if (solver->conf.verbosity) {
+        cout << "c [cube] depth: " << depth
+        << " candidates: " << candidates.size()
+        << " cubes: " << (stats.cubes - orig_cubes)
+        << " refuted: " << (stats.refuted - orig_refuted)
+        << solver->conf.print_times(time_used)
+        << endl;
+    }
+
+    return !_cubes.empty();
+}
+
+void CubeFinder::pick_candidates()
+{
+    vector<std::pair<uint64_t, uint32_t>> occs;
+    for(uint32_t v = 0; v < solver->nVars(); v++) {
+        if (solver->value(v) != l_Undef
+            || solver->varData[v].removed != Removed::none
+            || solver->varData[v].is_bva
+        ) {
+            continue;
+        }
+        const uint64_t occ = solver->watches[Lit(v, false)].size()
+            + solver->watches[Lit(v, true)].size();
+        occs.push_back(std::make_pair(occ, v));
+    }
+
+    const size_t num = std::min<size_t>(occs.size(), solver->conf.cube_lookahead_vars);
+    std::partial_sort(occs.begin(), occs.begin() + num, occs.end(),
+        [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) {
+            return a.first > b.first;
+        }
+    );
+
+    candidates.clear();
+    for(size_t i = 0; i < num; i++) {
+        candidates.push_back(occs[i].second);
+    }
+}
+
+bool CubeFinder::enqueue_and_propagate(const Lit lit)
+{
+    solver->new_decision_level();
+    solver->enqueue<true>(lit);
+    return solver->propagate<true>().isNULL();
+}
+
+bool CubeFinder::lookahead(const Lit lit, uint64_t& props)
+{
+    const uint32_t level = solver->decisionLevel();
+    const size_t orig_trail_size = solver->trail_size();
+    stats.lookaheads++;
+
+    const bool ret = enqueue_and_propagate(lit);
+    props = solver->trail_size() - orig_trail_size;
+    solver->cancelUntil<false, true>(level);
+
+    return ret;
+}
+
+void CubeFinder::split(const uint32_t depth)
+{
+    if (depth == 0) {
+        add_cube();
+        return;
+    }
+
+    Lit best = lit_Undef;
+    uint64_t best_score = 0;
+    for(const uint32_t v: candidates) {
+        if (solver->value(v) != l_Undef) {
+            continue;
+        }
+
+        const Lit lit = Lit(v, false);
+        uint64_t props_pos;
+        uint64_t props_neg;
+        const bool pos_ok = lookahead(lit, props_pos);
+        const bool neg_ok = lookahead(~lit, props_neg);
+        if (!pos_ok && !neg_ok) {
+            stats.refuted++;
+            return;
+        }
+
+        if (!pos_ok || !neg_ok) {
+            //Failed literal, the other polarity is implied under this cube
+            stats.failed_lits++;
+            const Lit implied = pos_ok ? lit : ~lit;
+            const uint32_t level = solver->decisionLevel();
+            const bool ok = enqueue_and_propagate(implied);
+            assert(ok);
+            cube.push_back(implied);
+            split(depth);
+            cube.pop_back();
+            solver->cancelUntil<false, true>(level);
+            return;
+        }
+
+        const uint64_t score = (props_pos+1)*(props_neg+1);
+        if (best == lit_Undef || score > best_score) {
+            best = lit;
+            best_score = score;
+        }
+    }
+
+    //All candidates are set
+    if (best == lit_Undef) {
+        add_cube();
+        return;
+    }
+
+    const uint32_t level = solver->decisionLevel();
+    for(const Lit lit: {best, ~best}) {
+        if (enqueue_and_propagate(lit)) {
+            cube.push_back(lit);
+            split(depth-1);
+            cube.pop_back();
+        } else {
+            stats.refuted++;
+        }
+        solver->cancelUntil<false, true>(level);
+    }
+}
+
+void CubeFinder::add_cube()
+{
+    stats.cubes++;
+    cubes->push_back(vector<Lit>());
+    vector<Lit>& c = cubes->back();
+    for(const Lit lit: cube) {
+        const Lit outer = solver->map_inter_to_outer(lit);
+        c.push_back(Lit(outer_to_without_bva[outer.var()], outer.sign()));
+    }
+}
+
+void CubeFinder::Stats::print() const
+{
+    print_stats_line("c cube gen time"
+        , cpu_time
+        , "s"
+    );
+    print_stats_line("c cubes generated", cubes);
+    print_stats_line("c cubes refuted", refuted);
+    print_stats_line("c cube failed lits", failed_lits);
+    print_stats_line("c cube lookaheads", lookaheads);
+}
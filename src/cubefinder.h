@@ -0,0 +1,88 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef _CUBEFINDER_H_
+#define _CUBEFINDER_H_
+
+#include <vector>
+#include "solvertypes.h"
+
+using std::vector;
+
+namespace CMSat {
+
+class Solver;
+
+/**
+@brief Splits the problem into cubes for cube-and-conquer
+
+Runs a lookahead-based splitter on top of the solver's propagation engine.
+At every node, the candidate variable whose two polarities propagate the
+most (product of the two propagation counts) is branched on. Failed literals
+found during lookahead are added to the cube, and nodes where both
+polarities fail are dropped as refuted. Cubes are returned in the numbering
+of the outside world, ready to be used as assumptions.
+*/
+class CubeFinder
+{
+public:
+    CubeFinder(Solver* solver);
+
+    //Returns FALSE if all cubes have been refuted, i.e. the problem is UNSAT
+    bool find_cubes(const uint32_t depth, vector<vector<Lit>>& cubes);
+
+    struct Stats
+    {
+        uint64_t cubes = 0;
+        uint64_t refuted = 0;
+        uint64_t failed_lits = 0;
+        uint64_t lookaheads = 0;
+        double cpu_time = 0;
+
+        void print() const;
+    };
+    const Stats& get_stats() const;
+
+private:
+    void pick_candidates();
+    void split(const uint32_t depth);
+    bool lookahead(const Lit lit, uint64_t& props);
+    bool enqueue_and_propagate(const Lit lit);
+    void add_cube();
+
+    Solver* solver;
+    vector<uint32_t> candidates;
+    vector<uint32_t> outer_to_without_bva;
+    vector<Lit> cube;
+    vector<vector<Lit>>* cubes = NULL;
+    Stats stats;
+};
+
+inline const CubeFinder::Stats& CubeFinder::get_stats() const
+{
+    return stats;
+}
+
+} //end namespace
+
+#endif //_CUBEFINDER_H_
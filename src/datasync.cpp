@@ -24,6 +24,9 @@ THE SOFTWARE.
 #include "varreplacer.h"
 #include "solver.h"
 #include "shareddata.h"
+#ifdef USE_NETSYNC
+#include "netsync.h"
+#endif
 #include <iomanip>
 
 using namespace CMSat;
@@ -49,14 +52,51 @@ DataSync::DataSync(Solver* _solver, SharedData* _sharedData, bool _is_mpi) :
 #endif
 }
 
+DataSync::~DataSync()
+{
+    #ifdef USE_NETSYNC
+    delete netsync;
+    #endif
+}
+
 void DataSync::set_shared_data(SharedData* _sharedData)
 {
     sharedData = _sharedData;
+    longSyncFinish.clear();
+    if (sharedData != NULL) {
+        longSyncFinish.resize(sharedData->long_cls.size(), 0);
+    }
+}
+
+//Only the first thread talks to other processes. It shares what it
+//learns itself, units and binaries it got from the other threads, too.
+void DataSync::start_net_sync()
+{
+    if (netsync != NULL
+        || solver->conf.thread_num != 0
+        || (solver->conf.sync_net_listen.empty()
+            && solver->conf.sync_net_connect.empty())
+    ) {
+        return;
+    }
+
+    #ifdef USE_NETSYNC
+    const bool serve = !solver->conf.sync_net_listen.empty();
+    netsync = new NetSync(
+        serve ? solver->conf.sync_net_listen : solver->conf.sync_net_connect
+        , serve
+        , solver->nVarsOutside()
+        , solver->get_input_hash()
+        , solver->conf.verbosity);
+    #else
+    std::cerr << "ERROR: Sharing clauses between processes was not compiled in" << endl;
+    std::exit(-1);
+    #endif
 }
 
 void DataSync::new_var(const bool bva)
 {
-    if (!enabled())
+    if (sharedData == NULL)
         return;
 
     if (!bva) {
@@ -68,7 +108,7 @@ void DataSync::new_var(const bool bva)
 
 void DataSync::new_vars(size_t n)
 {
-    if (!enabled())
+    if (sharedData == NULL)
         return;
 
     syncFinish.insert(syncFinish.end(), 2*n, 0);
@@ -90,16 +130,19 @@ void DataSync::updateVars(
 ) {
 }
 
+bool DataSync::sync_due() const
+{
+    return enabled()
+        && lastSyncConf + solver->conf.sync_every_confl < solver->sumConflicts;
+}
+
 bool DataSync::syncData()
 {
-    if (!enabled()
-        || lastSyncConf + solver->conf.sync_every_confl >= solver->sumConflicts
-    ) {
+    if (!sync_due()) {
         return true;
     }
     numCalls++;
 
-    assert(sharedData != NULL);
     assert(solver->decisionLevel() == 0);
 
     if (must_rebuild_bva_map) {
@@ -108,6 +151,15 @@ bool DataSync::syncData()
     }
 
     bool ok;
+    if (netsync != NULL) {
+        ok = syncNet();
+        if (!ok) return false;
+    }
+    if (sharedData == NULL) {
+        lastSyncConf = solver->sumConflicts;
+        return true;
+    }
+
     sharedData->unit_mutex.lock();
     ok = shareUnitData();
     sharedData->unit_mutex.unlock();
@@ -120,6 +172,23 @@ bool DataSync::syncData()
     sharedData->bin_mutex.unlock();
     if (!ok) return false;
 
+    if (solver->conf.sync_equivs) {
+        sharedData->equiv_mutex.lock();
+        ok = shareEquivData();
+        sharedData->equiv_mutex.unlock();
+        if (!ok) return false;
+    }
+
+    if (solver->conf.sync_phases) {
+        sharedData->phase_mutex.lock();
+        sharePhaseData();
+        sharedData->phase_mutex.unlock();
+    }
+
+    //Long clauses are exchanged through lock-free rings, no mutex needed
+    ok = syncLongFromOthers();
+    if (!ok) return false;
+
     #ifdef USE_MPI
     if (is_mpi && mpiSize > 1 && solver->conf.thread_num == 0) {
         sharedData->unit_mutex.lock();
@@ -363,6 +432,338 @@ bool DataSync::shareUnitData()
     return true;
 }
 
+Lit DataSync::outside_to_inter(Lit lit) const
+{
+    lit = solver->map_to_with_bva(lit);
+    lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+    return solver->map_outer_to_inter(lit);
+}
+
+//Equivalences are imported as the two binary clauses that make them up.
+//Our own SCC will then find them and the next replacement will apply them.
+bool DataSync::shareEquivData()
+{
+    uint32_t thisGotEquivData = 0;
+    uint32_t thisSentEquivData = 0;
+
+    SharedData& shared = *sharedData;
+    if (shared.equiv.size() < solver->nVarsOutside()) {
+        shared.equiv.resize(solver->nVarsOutside(), lit_Undef);
+    }
+    equivImported.resize(solver->nVarsOutside(), lit_Undef);
+
+    vector<Lit> lits(2);
+    for (uint32_t var = 0; var < solver->nVarsOutside(); var++) {
+        const Lit outer = solver->map_to_with_bva(Lit(var, false));
+        const Lit repl = solver->varReplacer->get_lit_replaced_with_outer(outer);
+
+        if (shared.equiv[var] == lit_Undef) {
+            if (repl == outer) {
+                continue;
+            }
+            //The replacing literal can be a BVA variable, that's not shared
+            if (repl.var() >= outer_to_without_bva_map.size()
+                || outer_to_without_bva_map[repl.var()] == var_Undef
+            ) {
+                continue;
+            }
+            const uint32_t repl_var = outer_to_without_bva_map[repl.var()];
+            shared.equiv[var] = Lit(repl_var, repl.sign());
+            equivImported[var] = shared.equiv[var];
+            thisSentEquivData++;
+            continue;
+        }
+
+        const Lit other = shared.equiv[var];
+        if (equivImported[var] == other
+            || other.var() >= solver->nVarsOutside()
+        ) {
+            continue;
+        }
+        equivImported[var] = other;
+
+        const Lit lit1 = solver->map_outer_to_inter(repl);
+        const Lit lit2 = outside_to_inter(other);
+        if (lit1 == lit2
+            || solver->varData[lit1.var()].removed != Removed::none
+            || solver->varData[lit2.var()].removed != Removed::none
+            || solver->value(lit1) != l_Undef
+            || solver->value(lit2) != l_Undef
+        ) {
+            continue;
+        }
+
+        //Don't add DRAT: it would add to the thread data, too
+        thisGotEquivData++;
+        lits[0] = lit1;
+        lits[1] = ~lit2;
+        solver->add_clause_int(lits, true, ClauseStats(), true, NULL, false);
+        if (!solver->okay()) {
+            return false;
+        }
+        lits[0] = ~lit1;
+        lits[1] = lit2;
+        solver->add_clause_int(lits, true, ClauseStats(), true, NULL, false);
+        if (!solver->okay()) {
+            return false;
+        }
+    }
+
+    if (solver->conf.verbosity >= 3) {
+        cout
+        << "c [sync] got equivs " << thisGotEquivData
+        << " sent equivs " << thisSentEquivData
+        << endl;
+    }
+    stats.recvEquivData += thisGotEquivData;
+    stats.sentEquivData += thisSentEquivData;
+
+    return true;
+}
+
+//Trail lengths of different threads are not exactly comparable, as they
+//may have eliminated or replaced different variables. It's only a heuristic.
+void DataSync::sharePhaseData()
+{
+    SharedData& shared = *sharedData;
+    if (shared.best_phase.size() < solver->nVarsOutside()) {
+        shared.best_phase.resize(solver->nVarsOutside(), l_Undef);
+    }
+
+    if (solver->longest_trail_ever > shared.best_phase_trail) {
+        for (uint32_t var = 0; var < solver->nVarsOutside(); var++) {
+            const Lit lit = outside_to_inter(Lit(var, false));
+            if (solver->varData[lit.var()].removed != Removed::none) {
+                continue;
+            }
+            lbool val = solver->value(lit);
+            if (val == l_Undef) {
+                val = boolToLBool(solver->varData[lit.var()].best_polarity ^ lit.sign());
+            }
+            shared.best_phase[var] = val;
+        }
+        shared.best_phase_trail = solver->longest_trail_ever;
+        shared.best_phase_version++;
+        phaseVersionSeen = shared.best_phase_version;
+        stats.sentPhaseData++;
+        return;
+    }
+
+    //Our own longest trail keeps on overriding them, as before
+    if (shared.best_phase_version != phaseVersionSeen) {
+        for (uint32_t var = 0; var < solver->nVarsOutside(); var++) {
+            const lbool val = shared.best_phase[var];
+            if (val == l_Undef) {
+                continue;
+            }
+            const Lit lit = outside_to_inter(Lit(var, false));
+            if (solver->varData[lit.var()].removed != Removed::none
+                || solver->value(lit) != l_Undef
+            ) {
+                continue;
+            }
+            solver->varData[lit.var()].best_polarity = (val == l_True) ^ lit.sign();
+        }
+        phaseVersionSeen = shared.best_phase_version;
+        stats.recvPhaseData++;
+    }
+}
+
+//Units and binaries are sent as they are found, long clauses as they
+//are learnt, see signalNewLongClause()
+bool DataSync::syncNet()
+{
+    #ifdef USE_NETSYNC
+    vector<Lit> lits(1);
+    netUnitSent.resize(solver->nVarsOutside(), 0);
+    for (uint32_t var = 0; var < solver->nVarsOutside(); var++) {
+        if (netUnitSent[var]) {
+            continue;
+        }
+        const lbool val = solver->value(outside_to_inter(Lit(var, false)));
+        if (val != l_Undef) {
+            lits[0] = Lit(var, val == l_False);
+            netsync->send(lits, 1);
+            netUnitSent[var] = 1;
+            stats.sentNetData++;
+        }
+    }
+
+    lits.resize(2);
+    for(const std::pair<Lit, Lit>& bin: newBinClauses) {
+        lits[0] = bin.first;
+        lits[1] = bin.second;
+        netsync->send(lits, 1);
+        stats.sentNetData++;
+    }
+    if (sharedData == NULL) {
+        newBinClauses.clear();
+    }
+
+    netsync->exchange();
+    uint32_t glue;
+    while(netsync->get(lits, glue)) {
+        if (!add_cl_from_other(lits, glue, stats.recvNetData)) {
+            //Drain, so the next call won't see them
+            while(netsync->get(lits, glue)) {}
+            return false;
+        }
+    }
+    #endif
+
+    return solver->okay();
+}
+
+bool DataSync::syncLongFromOthers()
+{
+    if (solver->conf.sync_long_max_size < 3) {
+        return true;
+    }
+
+    const uint64_t oldRecvLongData = stats.recvLongData;
+    const uint64_t oldLostLongData = stats.lostLongData;
+    vector<Lit> lits;
+    for(uint32_t th = 0; th < sharedData->long_cls.size(); th++) {
+        if (th == solver->conf.thread_num) {
+            continue;
+        }
+
+        const SharedData::ClauseRing& ring = sharedData->long_cls[th];
+        const uint64_t head = ring.get_head();
+        uint64_t& at = longSyncFinish[th];
+        if (head - at > SharedData::ClauseRing::num_slots) {
+            stats.lostLongData += head - at - SharedData::ClauseRing::num_slots;
+            at = head - SharedData::ClauseRing::num_slots;
+        }
+
+        for(; at < head; at++) {
+            uint32_t glue;
+            if (!ring.get(at, lits, glue)) {
+                stats.lostLongData++;
+                continue;
+            }
+            if (!add_cl_from_other(lits, glue, stats.recvLongData)) {
+                at++;
+                return false;
+            }
+        }
+    }
+
+    if (solver->conf.verbosity >= 3) {
+        cout
+        << "c [sync] got long " << (stats.recvLongData - oldRecvLongData)
+        << " lost long " << (stats.lostLongData - oldLostLongData)
+        << " sent long total " << stats.sentLongData
+        << endl;
+    }
+
+    return true;
+}
+
+bool DataSync::add_cl_from_other(
+    const vector<Lit>& lits
+    , const uint32_t glue
+    , uint64_t& num_added
+) {
+    tmp_long_cl.clear();
+    for(Lit lit: lits) {
+        if (lit.var() >= solver->nVarsOutside()) {
+            return true;
+        }
+        lit = solver->map_to_with_bva(lit);
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
+        if (solver->varData[lit.var()].removed != Removed::none
+            || solver->value(lit) == l_True
+        ) {
+            return true;
+        }
+        tmp_long_cl.push_back(lit);
+    }
+    num_added++;
+
+    ClauseStats cl_stats;
+    cl_stats.glue = std::min<uint32_t>(glue, tmp_long_cl.size());
+    cl_stats.is_imported = true;
+
+    //The tier must be known before allocation, it selects the arena
+    if (cl_stats.glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
+        cl_stats.which_red_array = 0;
+    } else if (cl_stats.glue <= solver->conf.glue_put_lev1_if_below_or_eq
+        && solver->conf.glue_put_lev1_if_below_or_eq != 0
+    ) {
+        cl_stats.which_red_array = 1;
+    } else {
+        cl_stats.which_red_array = 2;
+    }
+
+    //Don't add DRAT: it would add to the thread data, too
+    Clause* cl = solver->add_clause_int(
+        tmp_long_cl, true, cl_stats, true, NULL, false);
+    if (cl != NULL) {
+        solver->longRedCls[cl->stats.which_red_array].push_back(
+            solver->cl_alloc.get_offset(cl));
+    }
+
+    return solver->okay();
+}
+
+void DataSync::signalNewLongClause(const vector<Lit>& cl, const uint32_t glue)
+{
+    if (!enabled()
+        || cl.size() > solver->conf.sync_long_max_size
+        || cl.size() > SharedData::ClauseRing::max_size
+        || glue > solver->conf.sync_long_max_glue
+    ) {
+        return;
+    }
+
+    if (must_rebuild_bva_map) {
+        outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
+        must_rebuild_bva_map = false;
+    }
+
+    tmp_long_cl.clear();
+    for(Lit lit: cl) {
+        if (solver->varData[lit.var()].is_bva)
+            return;
+
+        lit = solver->map_inter_to_outer(lit);
+        tmp_long_cl.push_back(map_outside_without_bva(lit));
+    }
+    if (sharedData != NULL) {
+        sharedData->long_cls[solver->conf.thread_num].push(tmp_long_cl, glue);
+        stats.sentLongData++;
+    }
+    #ifdef USE_NETSYNC
+    if (netsync != NULL) {
+        netsync->send(tmp_long_cl, glue);
+        stats.sentNetData++;
+    }
+    #endif
+}
+
+void DataSync::Stats::print() const
+{
+    print_stats_line("c sync sent unit/bin/long"
+        , sentUnitData
+        , sentBinData
+        , sentLongData
+    );
+    print_stats_line("c sync recv unit/bin/long"
+        , recvUnitData
+        , recvBinData
+        , recvLongData
+    );
+    print_stats_line("c sync long lost", lostLongData);
+    print_stats_line("c sync sent equivs", sentEquivData);
+    print_stats_line("c sync recv equivs", recvEquivData);
+    print_stats_line("c sync sent best phases", sentPhaseData);
+    print_stats_line("c sync recv best phases", recvPhaseData);
+    print_stats_line("c sync sent to processes", sentNetData);
+    print_stats_line("c sync recv from processes", recvNetData);
+}
+
 void DataSync::signalNewBinClause(Lit lit1, Lit lit2)
 {
     if (!enabled()) {
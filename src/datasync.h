@@ -32,15 +32,19 @@ namespace CMSat {
 
 class SharedData;
 class Solver;
+class NetSync;
 class DataSync
 {
     public:
         DataSync(Solver* solver, SharedData* sharedData, bool is_mpi);
-        bool enabled();
+        ~DataSync();
+        bool enabled() const;
         void set_shared_data(SharedData* sharedData);
+        void start_net_sync();
         void new_var(const bool bva);
         void new_vars(const size_t n);
         bool syncData();
+        bool sync_due() const;
         void save_on_var_memory();
         void rebuild_bva_map();
         void updateVars(
@@ -50,6 +54,7 @@ class DataSync
 
         template <class T> void signalNewBinClause(T& ps);
         void signalNewBinClause(Lit lit1, Lit lit2);
+        void signalNewLongClause(const vector<Lit>& cl, const uint32_t glue);
 
         struct Stats
         {
@@ -57,6 +62,17 @@ class DataSync
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint64_t sentLongData = 0;
+            uint64_t recvLongData = 0;
+            uint64_t lostLongData = 0;
+            uint32_t sentEquivData = 0;
+            uint32_t recvEquivData = 0;
+            uint32_t sentPhaseData = 0;
+            uint32_t recvPhaseData = 0;
+            uint64_t sentNetData = 0;
+            uint64_t recvNetData = 0;
+
+            void print() const;
         };
         const Stats& get_stats() const;
 
@@ -70,9 +86,20 @@ class DataSync
         void clear_set_binary_values();
         void addOneBinToOthers(const Lit lit1, const Lit lit2);
         bool shareBinData();
+        bool syncLongFromOthers();
+        bool add_cl_from_other(const vector<Lit>& lits, const uint32_t glue, uint64_t& num_added);
+        bool syncNet();
+        Lit outside_to_inter(const Lit lit) const;
+        bool shareEquivData();
+        void sharePhaseData();
 
         //stuff to sync
         vector<std::pair<Lit, Lit> > newBinClauses;
+        vector<uint64_t> longSyncFinish;
+        vector<Lit> tmp_long_cl;
+        vector<Lit> equivImported; ///<per outside var, what we last added from SharedData::equiv
+        uint64_t phaseVersionSeen = 0;
+        vector<char> netUnitSent;
 
         //stats
         uint64_t lastSyncConf = 0;
@@ -82,6 +109,7 @@ class DataSync
         //Other systems
         Solver* solver;
         SharedData* sharedData;
+        NetSync* netsync = NULL; ///<only thread 0 talks to other processes
 
 
         //MPI
@@ -125,7 +153,7 @@ inline const DataSync::Stats& DataSync::get_stats() const
 template <class T>
 inline void DataSync::signalNewBinClause(T& ps)
 {
-    if (sharedData == NULL) {
+    if (!enabled()) {
         return;
     }
     //assert(ps.size() == 2);
@@ -138,9 +166,9 @@ inline Lit DataSync::map_outside_without_bva(const Lit lit) const
 
 }
 
-inline bool DataSync::enabled()
+inline bool DataSync::enabled() const
 {
-    return sharedData != NULL;
+    return sharedData != NULL || netsync != NULL;
 }
 
 }
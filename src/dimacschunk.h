@@ -0,0 +1,222 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef DIMACSCHUNK_H
+#define DIMACSCHUNK_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//Parse 8 digits at once in a 64b register. Needs little endian byte order.
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CMS_SWAR_DIGITS
+#endif
+
+namespace CMSat {
+
+//Start of the line after the one 'p' is in
+inline const char* dimacs_next_line(const char* p, const char* end)
+{
+    const char* nl = (const char*)memchr(p, '\n', end-p);
+    return nl ? nl+1 : end;
+}
+
+#ifdef CMS_SWAR_DIGITS
+//8 ASCII digits, first digit in the lowest byte
+inline uint32_t dimacs_swar_8digits(uint64_t w)
+{
+    w -= 0x3030303030303030ULL;
+    w = (w * 10) + (w >> 8);
+    w = (((w & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+        + (((w >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (uint32_t)w;
+}
+#endif
+
+//Parses the decimal number at 'p', which must start with a digit.
+//Returns false for numbers over 9 digits, which are certainly not valid
+//variables -- the sequential parser will produce the error message
+inline bool dimacs_parse_uint(const char*& p, const char* end, uint32_t& val)
+{
+    const char* const num_start = p;
+    val = 0;
+
+    #ifdef CMS_SWAR_DIGITS
+    if (end - p >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+
+        //Non-zero bytes are the non-digits. Carries from '+ 0x06' only go
+        //upwards, i.e. past the first non-digit, so they don't matter
+        const uint64_t nondigit =
+            ((w & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL)
+            | (((w + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL)
+                ^ 0x3030303030303030ULL);
+        if (nondigit != 0) {
+            const unsigned n = __builtin_ctzll(nondigit)/8;
+            //Move the digits to the top, pad with leading '0'-s
+            w = (w << (8*(8-n))) | (0x3030303030303030ULL >> (8*n));
+            val = dimacs_swar_8digits(w);
+            p += n;
+            return true;
+        }
+        val = dimacs_swar_8digits(w);
+        p += 8;
+    }
+    #endif
+
+    while (p != end && *p >= '0' && *p <= '9') {
+        val = val*10 + (*p - '0');
+        p++;
+        if (p - num_start > 9) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//A line-aligned piece of a DIMACS file. parse() can run in a worker thread:
+//it only deals with plain clause lines and does not touch the solver.
+//Everything else (header, comments, xor clauses, malformed lines) is kept
+//as a raw text range for the sequential parser, in order.
+struct DimacsChunk
+{
+    struct Raw {
+        size_t lits_at; //comes right before the clause starting at lits[lits_at]
+        const char* start;
+        const char* end;
+    };
+
+    const char* start;
+    const char* end;
+    std::vector<int32_t> lits; //each clause terminated by 0
+    std::vector<Raw> raw;
+
+    void parse()
+    {
+        lits.clear();
+        raw.clear();
+        const char* p = start;
+        while (p != end) {
+            const char* const line = p;
+            const size_t lits_at = lits.size();
+            if (!parse_clause_line(p)) {
+                lits.resize(lits_at);
+                p = dimacs_next_line(line, end);
+                if (!raw.empty()
+                    && raw.back().lits_at == lits_at
+                    && raw.back().end == line
+                ) {
+                    raw.back().end = p;
+                } else {
+                    raw.push_back(Raw{lits_at, line, p});
+                }
+            }
+        }
+    }
+
+private:
+    static bool is_ws(const char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    void skip_ws(const char*& p) const
+    {
+        while (p != end && is_ws(*p)) {
+            p++;
+        }
+    }
+
+    //Accepts exactly what StreamBuffer::parseInt + DimacsParser::readClause
+    //accept, i.e. a single clause with a ' ' after every literal
+    bool parse_clause_line(const char*& p)
+    {
+        for (;;) {
+            skip_ws(p);
+            if (p == end) {
+                return false;
+            }
+            int32_t mult = 1;
+            if (*p == '-') {
+                mult = -1;
+                p++;
+            } else if (*p == '+') {
+                p++;
+            }
+            if (p == end || *p < '0' || *p > '9') {
+                return false;
+            }
+
+            uint32_t val;
+            if (!dimacs_parse_uint(p, end, val)) {
+                return false;
+            }
+            lits.push_back(mult*(int32_t)val);
+            if (val == 0) {
+                break;
+            }
+            if (p == end || *p != ' ') {
+                return false;
+            }
+        }
+
+        skip_ws(p);
+        if (p == end) {
+            return true;
+        }
+        if (*p != '\n') {
+            return false;
+        }
+        p++;
+        return true;
+    }
+};
+
+//Cuts [start, end) at line boundaries into at most 'num' similar chunks
+inline void dimacs_split_chunks(
+    const char* start,
+    const char* end,
+    size_t num,
+    std::vector<DimacsChunk>& chunks)
+{
+    chunks.resize(num);
+    const size_t per_chunk = (end - start)/num + 1;
+    size_t at = 0;
+    while (start != end) {
+        const char* chunk_end = end;
+        if ((size_t)(end - start) > per_chunk) {
+            chunk_end = dimacs_next_line(start + per_chunk, end);
+        }
+        chunks[at].start = start;
+        chunks[at].end = chunk_end;
+        at++;
+        start = chunk_end;
+    }
+    chunks.resize(at);
+}
+
+}
+
+#endif //DIMACSCHUNK_H
@@ -26,8 +26,11 @@ THE SOFTWARE.
 
 #include <string.h>
 #include "streambuffer.h"
+#include "mmapfile.h"
+#include "dimacschunk.h"
 #include <cstdlib>
 #include <cmath>
+#include <thread>
 
 using namespace CMSat;
 using std::vector;
@@ -42,6 +45,15 @@ class DimacsParser
             T input_stream,
             const bool strict_header,
             uint32_t offset_vars = 0);
+
+        //Only for C = StreamBuffer<MemRange, MR>. Plain clause lines are
+        //parsed by num_threads worker threads (0 = one per core), everything
+        //else goes through the sequential parser, in file order
+        bool parse_DIMACS_mmap(
+            const MMapFile& file,
+            const bool strict_header,
+            unsigned num_threads = 0,
+            uint32_t offset_vars = 0);
         uint64_t max_var = std::numeric_limits<uint64_t>::max();
         vector<uint32_t> sampling_vars;
         vector<double> weights;
@@ -51,6 +63,8 @@ class DimacsParser
     private:
         bool parse_DIMACS_main(C& in);
         bool readClause(C& in);
+        bool add_parsed_lit(const int32_t parsed_lit);
+        bool add_parsed_chunks(vector<DimacsChunk>& chunks);
         bool parse_and_add_clause(C& in);
         bool parse_and_add_xor_clause(C& in);
         bool match(C& in, const char* str);
@@ -130,11 +144,64 @@ std::string DimacsParser<C, S>::stringify(uint32_t x) const
     return o.str();
 }
 
+template<class C, class S>
+bool DimacsParser<C, S>::add_parsed_lit(const int32_t parsed_lit)
+{
+    uint32_t var = std::abs(parsed_lit)-1;
+    var += offset_vars;
+
+    if (var > max_var) {
+        std::cerr
+        << "ERROR! "
+        << "Variable requested is too large for DIMACS parser parameter: "
+        << var << endl
+        << "--> At line " << lineNum+1
+        << please_read_dimacs
+        << endl;
+        return false;
+    }
+
+    if (var >= (1ULL<<28)) {
+        std::cerr
+        << "ERROR! "
+        << "Variable requested is far too large: " << var + 1 << endl
+        << "--> At line " << lineNum+1
+        << please_read_dimacs
+        << endl;
+        return false;
+    }
+
+    if (strict_header && !header_found) {
+        std::cerr
+        << "ERROR! "
+        << "DIMACS header ('p cnf vars cls') never found!" << endl;
+        return false;
+    }
+
+    if ((int)var >= num_header_vars && strict_header) {
+        std::cerr
+        << "ERROR! "
+        << "Variable requested is larger than the header told us." << endl
+        << " -> var is : " << var + 1 << endl
+        << " -> header told us maximum will be : " << num_header_vars << endl
+        << " -> At line " << lineNum+1
+        << endl;
+        return false;
+    }
+
+    if (var >= solver->nVars()) {
+        assert(!strict_header);
+        solver->new_vars(var - solver->nVars() +1);
+    }
+
+    lits.push_back( (parsed_lit > 0) ? Lit(var, false) : Lit(var, true) );
+    return true;
+}
+
 template<class C, class S>
 bool DimacsParser<C, S>::readClause(C& in)
 {
     int32_t parsed_lit;
-    uint32_t var;
     for (;;) {
         if (!in.parseInt(parsed_lit, lineNum)) {
             return false;
@@ -143,54 +210,9 @@ bool DimacsParser<C, S>::readClause(C& in)
             break;
         }
 
-        var = std::abs(parsed_lit)-1;
-        var += offset_vars;
-
-        if (var > max_var) {
-            std::cerr
-            << "ERROR! "
-            << "Variable requested is too large for DIMACS parser parameter: "
-            << var << endl
-            << "--> At line " << lineNum+1
-            << please_read_dimacs
-            << endl;
-            return false;
-        }
-
-        if (var >= (1ULL<<28)) {
-            std::cerr
-            << "ERROR! "
-            << "Variable requested is far too large: " << var + 1 << endl
-            << "--> At line " << lineNum+1
-            << please_read_dimacs
-            << endl;
-            return false;
-        }
-
-        if (strict_header && !header_found) {
-            std::cerr
-            << "ERROR! "
-            << "DIMACS header ('p cnf vars cls') never found!" << endl;
+        if (!add_parsed_lit(parsed_lit)) {
             return false;
         }
-
-        if ((int)var >= num_header_vars && strict_header) {
-            std::cerr
-            << "ERROR! "
-            << "Variable requested is larger than the header told us." << endl
-            << " -> var is : " << var + 1 << endl
-            << " -> header told us maximum will be : " << num_header_vars << endl
-            << " -> At line " << lineNum+1
-            << endl;
-            return false;
-        }
-
-        if (var >= solver->nVars()) {
-            assert(!strict_header);
-            solver->new_vars(var - solver->nVars() +1);
-        }
-
-        lits.push_back( (parsed_lit > 0) ? Lit(var, false) : Lit(var, true) );
         if (*in != ' ') {
             std::cerr
             << "ERROR! "
@@ -606,6 +628,105 @@ bool DimacsParser<C, S>::parse_DIMACS(
     return true;
 }
 
+template <class C, class S>
+bool DimacsParser<C, S>::add_parsed_chunks(vector<DimacsChunk>& chunks)
+{
+    for(DimacsChunk& chunk: chunks) {
+        auto raw = chunk.raw.begin();
+        size_t at = 0;
+        for (;;) {
+            while (raw != chunk.raw.end() && raw->lits_at == at) {
+                C in(MemRange{raw->start, raw->end});
+                if (!parse_DIMACS_main(in)) {
+                    return false;
+                }
+                ++raw;
+            }
+            if (at == chunk.lits.size()) {
+                break;
+            }
+
+            lits.clear();
+            for (int32_t parsed_lit = chunk.lits[at++]
+                ; parsed_lit != 0
+                ; parsed_lit = chunk.lits[at++]
+            ) {
+                if (!add_parsed_lit(parsed_lit)) {
+                    return false;
+                }
+            }
+            lineNum++;
+            solver->add_clause(lits);
+            norm_clauses_added++;
+        }
+    }
+    return true;
+}
+
+template <class C, class S>
+bool DimacsParser<C, S>::parse_DIMACS_mmap(
+    const MMapFile& file,
+    const bool _strict_header,
+    unsigned num_threads,
+    uint32_t _offset_vars)
+{
+    debugLibPart = 1;
+    strict_header = _strict_header;
+    offset_vars = _offset_vars;
+    const uint32_t origNumVars = solver->nVars();
+    if (num_threads == 0) {
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    //Bounds the memory used for parsed-but-not-yet-added clauses
+    const size_t window_sz = (size_t)num_threads*(4ULL*1024ULL*1024ULL);
+    const char* const file_end = file.data() + file.size();
+    const char* at = file.data();
+    vector<std::thread> workers;
+    auto start_window = [&](vector<DimacsChunk>& chunks) {
+        const char* window_end = file_end;
+        if ((size_t)(file_end - at) > window_sz) {
+            window_end = dimacs_next_line(at + window_sz, file_end);
+        }
+        dimacs_split_chunks(at, window_end, num_threads, chunks);
+        at = window_end;
+        for(DimacsChunk& chunk: chunks) {
+            workers.push_back(std::thread(&DimacsChunk::parse, &chunk));
+        }
+    };
+    auto join_workers = [&]() {
+        for(std::thread& t: workers) {
+            t.join();
+        }
+        workers.clear();
+    };
+
+    //Window N+1 is parsed while window N is added to the solver
+    vector<DimacsChunk> cur;
+    vector<DimacsChunk> next;
+    start_window(cur);
+    join_workers();
+    while (!cur.empty()) {
+        start_window(next);
+        const bool ok = add_parsed_chunks(cur);
+        join_workers();
+        if (!ok) {
+            return false;
+        }
+        std::swap(cur, next);
+    }
+
+    if (verbosity) {
+        cout
+        << "c -- clauses added: " << norm_clauses_added << endl
+        << "c -- xor clauses added: " << xor_clauses_added << endl
+        << "c -- vars added " << (solver->nVars() - origNumVars)
+        << endl;
+    }
+
+    return true;
+}
+
 template <class C, class S>
 bool DimacsParser<C, S>::parseIndependentSet(C& in)
 {
@@ -299,7 +299,7 @@ ClOffset DistillerLong::try_distill_clause_and_return_new(
             assert(val == l_True);
             cl[j++] = cl[i];
             True_confl = true;
-            confl = solver->varData[cl[i].var()].reason;
+            confl = solver->varReason[cl[i].var()];
             break;
         }
     }
@@ -0,0 +1,51 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef EXTERNALCALLBACKS_H
+#define EXTERNALCALLBACKS_H
+
+#include <cstdint>
+#include <mutex>
+
+namespace CMSat {
+
+//Callbacks set through the library API (e.g. IPASIR). A single instance is
+//owned by SATSolver and shared by all of its threads.
+struct ExternalCallbacks
+{
+    //Polled by thread 0 every few hundred conflicts. A non-zero return
+    //interrupts all threads.
+    int (*terminate)(void* state) = NULL;
+    void* terminate_state = NULL;
+
+    //Receives the learnt clauses of at most learn_max_len literals, in the
+    //user's numbering, 0-terminated. Calls from different threads are
+    //serialized through learn_mutex.
+    void (*learn)(void* state, int* clause) = NULL;
+    void* learn_state = NULL;
+    uint32_t learn_max_len = 0;
+    std::mutex learn_mutex;
+};
+
+}
+
+#endif //EXTERNALCALLBACKS_H
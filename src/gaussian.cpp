@@ -123,7 +123,7 @@ struct ColSorter {
         }
 
         return false;
-        //return solver->varData[a].level < solver->varData[b].level;
+        //return solver->varLevel[a] < solver->varLevel[b];
         //return solver->var_act_vsids[a] > solver->var_act_vsids[b];
     }
 
@@ -179,7 +179,7 @@ uint32_t EGaussian::select_columnorder() {
         cout << "assump:" << (int)assump
         << " act: " << std::setprecision(2) << std::scientific
         << solver->var_act_vsids[x] << std::fixed
-        << " level: " << solver->varData[x].level
+        << " level: " << solver->varLevel[x]
         << endl;
     }
     #endif
@@ -585,7 +585,7 @@ uint32_t EGaussian::get_max_level(const GaussQData& gqd, const uint32_t row_n)
 
     for (uint32_t i = 1; i < cl->size(); i++) {
         Lit l = (*cl)[i];
-        uint32_t nLevel = solver->varData[l.var()].level;
+        uint32_t nLevel = solver->varLevel[l.var()];
         if (nLevel > nMaxLevel) {
             nMaxLevel = nLevel;
             nMaxInd = i;
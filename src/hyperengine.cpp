@@ -55,7 +55,7 @@ Lit HyperEngine::propagate_bfs(const uint64_t timeout)
     if (trail.size() - trail_lim.back() == 1) {
         //Set up root node
         Lit root = trail[qhead].lit;
-        varData[root.var()].reason = PropBy(~lit_Undef, false, false, false);
+        varReason[root.var()] = PropBy(~lit_Undef, false, false, false);
     }
 
     uint32_t nlBinQHead = qhead;
@@ -146,6 +146,17 @@ Lit HyperEngine::propagate_bfs(const uint64_t timeout)
                     continue;
                 }
             }
+
+            if (i->isShared()) {
+                ret = prop_shared_cl_with_ancestor_info(i, j, p, confl);
+                if (ret == PROP_SOMETHING || ret == PROP_FAIL) {
+                    i++;
+                    break;
+                } else {
+                    assert(ret == PROP_NOTHING);
+                    continue;
+                }
+            }
         }
         propStats.bogoProps += ws.size()*4;
         while(i != end)
@@ -203,8 +214,8 @@ void HyperEngine::add_hyper_bin(const Lit p)
     }
 
     enqueue_with_acestor_info(p, deepestAncestor, true);
-    varData[p.var()].reason.setHyperbin(true);
-    varData[p.var()].reason.setHyperbinNotAdded(hyperBinNotAdded);
+    varReason[p.var()].setHyperbin(true);
+    varReason[p.var()].setHyperbinNotAdded(hyperBinNotAdded);
 }
 
 /**
@@ -218,7 +229,7 @@ Lit HyperEngine::remove_which_bin_due_to_trans_red(
     , bool thisStepRed
 ) {
     propStats.otfHyperTime += 1;
-    const PropBy& data = varData[conflict.var()].reason;
+    const PropBy& data = varReason[conflict.var()];
 
     bool onlyIrred = !data.isRedStep();
     Lit lookingForAncestor = data.getAncestor();
@@ -343,7 +354,7 @@ bool HyperEngine::is_ancestor_of(
     ) {
         #ifdef VERBOSE_DEBUG_FULLPROP
         cout << "Current acestor: " << thisAncestor
-        << " redundant step? " << varData[thisAncestor.var()].reason.isRedStep()
+        << " redundant step? " << varReason[thisAncestor.var()].isRedStep()
         << endl;
         #endif
 
@@ -362,7 +373,7 @@ bool HyperEngine::is_ancestor_of(
             return true;
         }
 
-        const PropBy& data = varData[thisAncestor.var()].reason;
+        const PropBy& data = varReason[thisAncestor.var()];
         if ((onlyIrred && data.isRedStep())
             || data.getHyperbinNotAdded()
         ) {
@@ -402,7 +413,7 @@ void HyperEngine::add_hyper_bin(const Lit p, const Clause& cl)
     ) {
         if (*it != p) {
             assert(value(*it) == l_False);
-            if (varData[it->var()].level != 0)
+            if (varLevel[it->var()] != 0)
                 currAncestors.push_back(~*it);
         }
     }
@@ -422,10 +433,10 @@ Lit HyperEngine::analyzeFail(const PropBy propBy)
     switch(propBy.getType()) {
         case binary_t: {
             const Lit lit = ~propBy.lit2();
-            if (varData[lit.var()].level != 0)
+            if (varLevel[lit.var()] != 0)
                 currAncestors.push_back(lit);
 
-            if (varData[failBinLit.var()].level != 0)
+            if (varLevel[failBinLit.var()] != 0)
                 currAncestors.push_back(~failBinLit);
 
             break;
@@ -435,12 +446,22 @@ Lit HyperEngine::analyzeFail(const PropBy propBy)
             const uint32_t offset = propBy.get_offset();
             const Clause& cl = *cl_alloc.ptr(offset);
             for(size_t i = 0; i < cl.size(); i++) {
-                if (varData[cl[i].var()].level != 0)
+                if (varLevel[cl[i].var()] != 0)
                     currAncestors.push_back(~cl[i]);
             }
             break;
         }
 
+        case shared_t: {
+            const uint32_t idx = propBy.get_shared_idx();
+            const Lit* lits = shared_cls_db->lits(idx);
+            for(size_t i = 0; i < shared_cls_db->cl_size(idx); i++) {
+                if (varLevel[lits[i].var()] != 0)
+                    currAncestors.push_back(~lits[i]);
+            }
+            break;
+        }
+
 #ifdef USE_GAUSS
         case xor_t:
 #endif
@@ -505,7 +526,7 @@ Lit HyperEngine::deepest_common_ancestor()
             }
 
             //Update ancestor to its own ancestor, i.e. step up this 'thread'
-            *it = varData[it->var()].reason.getAncestor();
+            *it = varReason[it->var()].getAncestor();
         }
     }
     #ifdef VERBOSE_DEBUG_FULLPROP
@@ -527,22 +548,22 @@ void HyperEngine::remove_bin_clause(Lit lit)
 {
     //The binary clause we should remove
     const BinaryClause clauseToRemove(
-        ~varData[lit.var()].reason.getAncestor()
+        ~varReason[lit.var()].getAncestor()
         , lit
-        , varData[lit.var()].reason.isRedStep()
+        , varReason[lit.var()].isRedStep()
     );
 
     //We now remove the clause
     //If it's hyper-bin, then we remove the to-be-added hyper-binary clause
     //However, if the hyper-bin was never added because only 1 literal was unbound at level 0 (i.e. through
     //clause cleaning, the clause would have been 2-long), then we don't do anything.
-    if (!varData[lit.var()].reason.getHyperbin()) {
+    if (!varReason[lit.var()].getHyperbin()) {
         #ifdef VERBOSE_DEBUG_FULLPROP
         cout << "Normal removing clause " << clauseToRemove << endl;
         #endif
         propStats.otfHyperTime += 2;
         uselessBin.insert(clauseToRemove);
-    } else if (!varData[lit.var()].reason.getHyperbinNotAdded()) {
+    } else if (!varReason[lit.var()].getHyperbinNotAdded()) {
         #ifdef VERBOSE_DEBUG_FULLPROP
         cout << "Removing hyper-bin clause " << clauseToRemove << endl;
         #endif
@@ -589,7 +610,7 @@ PropResult HyperEngine::prop_bin_with_ancestor_info(
         confl = PropBy(~p, k->red());
         return PROP_FAIL;
 
-    } else if (varData[lit.var()].level != 0 && perform_transitive_reduction) {
+    } else if (varLevel[lit.var()] != 0 && perform_transitive_reduction) {
         //Propaged already
         assert(val == l_True);
 
@@ -600,14 +621,14 @@ PropResult HyperEngine::prop_bin_with_ancestor_info(
 
         //Remove this one
         if (remove == p) {
-            Lit origAnc = varData[lit.var()].reason.getAncestor();
+            Lit origAnc = varReason[lit.var()].getAncestor();
             assert(origAnc != lit_Undef);
 
             remove_bin_clause(lit);
 
             //Update data indicating what lead to lit
-            varData[lit.var()].reason = PropBy(~p, k->red(), false, false);
-            assert(varData[p.var()].level != 0);
+            varReason[lit.var()] = PropBy(~p, k->red(), false, false);
+            assert(varLevel[p.var()] != 0);
             depth[lit.var()] = depth[p.var()] + 1;
             //NOTE: we don't update the levels of other literals... :S
 
@@ -659,6 +680,73 @@ PropResult HyperEngine::prop_normal_cl_with_ancestor_info(
     return PROP_SOMETHING;
 }
 
+//Same as prop_normal_cl_with_ancestor_info(), for a clause of the
+//SharedClauseDB. It can't be reordered, see PropEngine::prop_shared_cl()
+PropResult HyperEngine::prop_shared_cl_with_ancestor_info(
+    Watched* i
+    , Watched*& j
+    , const Lit p
+    , PropBy& confl
+) {
+    //Blocked literal is satisfied, so clause is satisfied
+    if (value(i->getBlockedLit()) == l_True) {
+        *j++ = *i;
+        return PROP_NOTHING;
+    }
+
+    propStats.bogoProps += 4;
+    const uint32_t idx = i->get_shared_idx();
+    const Lit* lits = shared_cls_db->lits(idx);
+    const uint32_t size = shared_cls_db->cl_size(idx);
+    uint32_t* w = shared_watched.data() + 2*idx;
+    if (lits[w[0]] == ~p) {
+        std::swap(w[0], w[1]);
+    }
+    assert(lits[w[1]] == ~p);
+
+    const Lit first = lits[w[0]];
+    const Watched neww(watch_shared_t, idx, first);
+    if (value(first) == l_True) {
+        *j++ = neww;
+        return PROP_NOTHING;
+    }
+
+    // Look for new watch:
+    for (uint32_t k = 0; k < size; k++) {
+        if (k == w[0] || k == w[1]) {
+            continue;
+        }
+        if (value(lits[k]) != l_False) {
+            w[1] = k;
+            watches[lits[k]].push(neww);
+            return PROP_NOTHING;
+        }
+    }
+
+    // Did not find watch -- clause is unit under assignment:
+    *j++ = neww;
+    if (value(first) == l_False) {
+        confl = PropBy(shared_t, idx);
+        #ifdef STATS_NEEDED
+        lastConflictCausedBy = ConflCausedBy::longirred;
+        #endif
+        qhead = trail.size();
+        return PROP_FAIL;
+    }
+
+    currAncestors.clear();
+    for (uint32_t k = 0; k < size; k++) {
+        if (lits[k] != first) {
+            assert(value(lits[k]) == l_False);
+            if (varLevel[lits[k].var()] != 0)
+                currAncestors.push_back(~lits[k]);
+        }
+    }
+    add_hyper_bin(first);
+
+    return PROP_SOMETHING;
+}
+
 size_t HyperEngine::mem_used() const
 {
     size_t mem = 0;
@@ -677,7 +765,7 @@ void HyperEngine::enqueue_with_acestor_info(
     //during intree probing
     enqueue(p, decisionLevel(), PropBy(~ancestor, redStep, false, false));
 
-    assert(varData[ancestor.var()].level != 0);
+    assert(varLevel[ancestor.var()] != 0);
 
     if (use_depth_trick) {
         depth[p.var()] = depth[ancestor.var()] + 1;
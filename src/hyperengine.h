@@ -85,6 +85,13 @@ private:
         , PropBy& confl
     );
 
+    PropResult prop_shared_cl_with_ancestor_info(
+        Watched* i
+        , Watched*& j
+        , const Lit p
+        , PropBy& confl
+    );
+
     vector<Lit> currAncestors;
 };
 
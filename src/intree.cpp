@@ -276,7 +276,7 @@ void InTree::tree_look()
                 ResetReason tmp = reset_reason_stack.back();
                 reset_reason_stack.pop_back();
                 if (tmp.var_reason_changed != var_Undef) {
-                    solver->varData[tmp.var_reason_changed].reason = tmp.orig_propby;
+                    solver->varReason[tmp.var_reason_changed] = tmp.orig_propby;
                     if (solver->conf.verbosity >= 10) {
                         cout << "RESet reason for VAR " << tmp.var_reason_changed+1 << " to:  ????" << /*tmp.orig_propby.lit2() << */ " red: " << (int)tmp.orig_propby.isRedStep() << endl;
                     }
@@ -322,8 +322,8 @@ bool InTree::handle_lit_popped_from_queue(const Lit lit, const Lit other_lit, co
     if (other_lit != lit_Undef) {
         //update 'other_lit' 's ancestor to 'lit'
         assert(solver->value(other_lit) == l_True);
-        reset_reason_stack.back() = ResetReason(other_lit.var(), solver->varData[other_lit.var()].reason);
-        solver->varData[other_lit.var()].reason = PropBy(~lit, red, false, false);
+        reset_reason_stack.back() = ResetReason(other_lit.var(), solver->varReason[other_lit.var()]);
+        solver->varReason[other_lit.var()] = PropBy(~lit, red, false, false);
         if (solver->conf.verbosity >= 10) {
             cout << "Set reason for VAR " << other_lit.var()+1 << " to: " << ~lit << " red: " << (int)red << endl;
         }
@@ -99,29 +99,49 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
     if (conf.verbosity) {
         cout << "c Reading file '" << filename << "'" << endl;
     }
-    #ifndef USE_ZLIB
-    FILE * in = fopen(filename.c_str(), "rb");
-    DimacsParser<StreamBuffer<FILE*, FN>, SATSolver> parser(solver2, &debugLib, conf.verbosity);
-    #else
-    gzFile in = gzopen(filename.c_str(), "rb");
-    DimacsParser<StreamBuffer<gzFile, GZ>, SATSolver> parser(solver2, &debugLib, conf.verbosity);
-    #endif
 
-    if (in == NULL) {
-        std::cerr
-        << "ERROR! Could not open file '"
-        << filename
-        << "' for reading: " << strerror(errno) << endl;
+    bool strict_header = conf.preprocess;
+    vector<uint32_t> parsed_sampling_vars;
 
-        std::exit(1);
-    }
+    MMapFile mfile;
+    if (mmap_parse && mfile.open(filename)) {
+        DimacsParser<StreamBuffer<MemRange, MR>, SATSolver> parser(solver2, &debugLib, conf.verbosity);
+        if (!parser.parse_DIMACS_mmap(mfile, strict_header, parse_threads)) {
+            exit(-1);
+        }
+        mfile.close();
+        parsed_sampling_vars.swap(parser.sampling_vars);
+    } else {
+        #ifndef USE_ZLIB
+        FILE * in = fopen(filename.c_str(), "rb");
+        DimacsParser<StreamBuffer<FILE*, FN>, SATSolver> parser(solver2, &debugLib, conf.verbosity);
+        #else
+        gzFile in = gzopen(filename.c_str(), "rb");
+        DimacsParser<StreamBuffer<gzFile, GZ>, SATSolver> parser(solver2, &debugLib, conf.verbosity);
+        #endif
+
+        if (in == NULL) {
+            std::cerr
+            << "ERROR! Could not open file '"
+            << filename
+            << "' for reading: " << strerror(errno) << endl;
+
+            std::exit(1);
+        }
 
-    bool strict_header = conf.preprocess;
-    if (!parser.parse_DIMACS(in, strict_header)) {
-        exit(-1);
+        if (!parser.parse_DIMACS(in, strict_header)) {
+            exit(-1);
+        }
+
+        #ifndef USE_ZLIB
+            fclose(in);
+        #else
+            gzclose(in);
+        #endif
+        parsed_sampling_vars.swap(parser.sampling_vars);
     }
 
-    if (!sampling_vars_str.empty() && !parser.sampling_vars.empty()) {
+    if (!sampling_vars_str.empty() && !parsed_sampling_vars.empty()) {
         cerr << "ERROR! Sampling vars set in console but also in CNF." << endl;
         exit(-1);
     }
@@ -140,7 +160,7 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
                 ss.ignore();
         }
     } else {
-        sampling_vars.swap(parser.sampling_vars);
+        sampling_vars.swap(parsed_sampling_vars);
     }
 
     if (sampling_vars.empty()) {
@@ -168,12 +188,6 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
     }
 
     call_after_parse();
-
-    #ifndef USE_ZLIB
-        fclose(in);
-    #else
-        gzclose(in);
-    #endif
 }
 
 void Main::readInStandardInput(SATSolver* solver2)
@@ -324,6 +338,14 @@ void Main::add_supported_options()
         , "[0..] Random seed")
     ("threads,t", po::value(&num_threads)->default_value(1)
         ,"Number of threads")
+    ("pinthreads", po::value(&conf.pin_threads)->default_value(conf.pin_threads)
+        , "Pin threads to CPUs, consecutive threads on different NUMA nodes, so each thread's memory is on its own node. Linux only")
+    ("syncserve", po::value(&conf.sync_net_listen)
+        , "Share clauses with the other solver processes that connect to this address: 'unix:PATH' or 'tcp:[HOST:]PORT', without HOST only on 127.0.0.1. They must solve the same problem. Peers are not authenticated")
+    ("syncconnect", po::value(&conf.sync_net_connect)
+        , "Share clauses with other solver processes through the one serving at this address: 'unix:PATH' or 'tcp:HOST:PORT'")
+    ("cube", po::value(&cube_depth)->default_value(cube_depth)
+        , "Cube-and-conquer: split the problem into at most 2^N cubes with lookahead and solve them on all threads. 0 = off")
     ("maxtime", po::value(&maxtime),
         "Stop solving after this much time (s)")
     ("maxconfl", po::value(&maxconfl),
@@ -392,6 +414,8 @@ void Main::add_supported_options()
         , "The multiplier used to determine if we should restart during glue-based restart")
     ("ratiogluegeom", po::value(&conf.ratio_glue_geom)->default_value(conf.ratio_glue_geom)
         , "Ratio of glue vs geometric restarts -- more is more glue")
+    ("reusetrail", po::value(&conf.restart_reuse_trail)->default_value(conf.restart_reuse_trail)
+        , "When restarting, keep the decision levels that would be re-created anyway")
     ;
 
     std::ostringstream s_incclean;
@@ -434,6 +458,8 @@ void Main::add_supported_options()
     ("branchstr"
         , po::value(&conf.branch_strategy_setup)->default_value(conf.branch_strategy_setup)
         , "Branch strategy string that switches between different branch strategies while solving e.g. 'maple1+maple2+vsids1+vsids2'")
+    ("orderheap4", po::value(&conf.order_heap_4ary)->default_value(conf.order_heap_4ary)
+        , "Use a 4-ary branching heap that keeps the activities inline, instead of the binary heap")
     ;
 
 
@@ -587,6 +613,8 @@ void Main::add_supported_options()
         , "Time-out in bogoprops M of strengthening of long clauses with long clauses, after computing occur")
     ("sublonggothrough", po::value(&conf.subsume_gothrough_multip)->default_value(conf.subsume_gothrough_multip)
         , "How many times go through subsume")
+    ("subthreads", po::value(&conf.subsume_threads)->default_value(conf.subsume_threads)
+        , "Threads for subsumption and strengthening of long clauses with long clauses. 1 = sequential, 0 = one per available core")
     ;
 
     po::options_description bva_options("BVA options");
@@ -619,6 +647,8 @@ void Main::add_supported_options()
         , "Eliminate this ratio of free variables at most per variable elimination iteration")
     ("skipresol", po::value(&conf.skip_some_bve_resolvents)->default_value(conf.skip_some_bve_resolvents)
         , "Skip BVE resolvents in case they belong to a gate")
+    ("bvethreads", po::value(&conf.varelim_threads)->default_value(conf.varelim_threads)
+        , "Threads for bounded variable elimination. 1 = sequential, 0 = one per core. The result does not depend on the number of threads as long as it's above 1")
     ;
 
     po::options_description xorOptions("XOR-related options");
@@ -783,6 +813,13 @@ void Main::add_supported_options()
         , "Timeout (in bogoprop Millions) of implicit strengthening")
     ("cardfind", po::value(&conf.doFindCard)->default_value(conf.doFindCard)
         , "Find cardinality constraints")
+    ("cubelookvars", po::value(&conf.cube_lookahead_vars)->default_value(conf.cube_lookahead_vars)
+        , "Number of most occurring variables to do lookahead on when splitting into cubes")
+    ("checkpoint", po::value(&conf.checkpoint_file)
+        , "Periodically save the full solver state to this file, and when an interrupt or a limit stops the run. It is written in the background and replaced atomically")
+    ("checkpointevery", po::value(&conf.checkpoint_every)->default_value(conf.checkpoint_every)
+        , "Save a checkpoint at most once every this many seconds of wall time")
+    ("resume", "Continue from the file given by --checkpoint instead of reading the input")
     ;
 
     po::options_description reconfOptions("Reconf options");
@@ -796,6 +833,18 @@ void Main::add_supported_options()
     hiddenOptions.add_options()
     ("sync", po::value(&conf.sync_every_confl)->default_value(conf.sync_every_confl)
         , "Sync threads every N conflicts")
+    ("synclongsz", po::value(&conf.sync_long_max_size)->default_value(conf.sync_long_max_size)
+        , "Share learnt clauses up to this size between threads. Below 3 disables long clause sharing")
+    ("synclongglue", po::value(&conf.sync_long_max_glue)->default_value(conf.sync_long_max_glue)
+        , "Share learnt long clauses between threads only if their glue is at most this")
+    ("syncequiv", po::value(&conf.sync_equivs)->default_value(conf.sync_equivs)
+        , "Share equivalent literals between threads")
+    ("syncphase", po::value(&conf.sync_phases)->default_value(conf.sync_phases)
+        , "Share the phases of the longest trail between threads, used when rephasing to the best phases")
+    ("portfolioevery", po::value(&conf.portfolio_reconf_every)->default_value(conf.portfolio_reconf_every)
+        , "Every this many seconds, reconfigure the thread doing worst (conflicts/s, low-glue learnts, trail depth, use of imported clauses). Thread 0 is never reconfigured. 0 = never")
+    ("sharedirred", po::value(&conf.share_irred_db)->default_value(conf.share_irred_db)
+        , "All threads but the first watch one shared, read-only copy of the long irredundant clauses instead of owning one each. The first thread keeps its own copy, so the clauses are stored twice instead of once per thread: this only saves memory from 3 threads up. The other threads don't simplify")
     ("dratdebug", po::bool_switch(&dratDebug)
         , "Output DRAT verification into the console. Helpful to see where DRAT fails -- use in conjunction with --verb 20")
     ("clearinter", po::value(&need_clean_exit)->default_value(0)
@@ -816,6 +865,10 @@ void Main::add_supported_options()
         , "Print and ban(!) solutions only in terms of variables declared in 'c ind' or as --sampling '...'")
     ("assump", po::value(&assump_filename)->default_value(assump_filename)
         , "Assumptions file")
+    ("mmapparse", po::value(&mmap_parse)->default_value(mmap_parse)
+        , "Parse regular, uncompressed CNF files through mmap, with multiple threads")
+    ("parsethreads", po::value(&parse_threads)->default_value(parse_threads)
+        , "Number of threads parsing clauses with --mmapparse. 0 = one per core")
 
     //these a kind of special and determine positional options' meanings
     ("input", po::value< vector<string> >(), "file(s) to read")
@@ -1193,6 +1246,45 @@ void Main::manually_parse_some_options()
         }
     }
 
+    if (vm.count("resume")) {
+        if (conf.checkpoint_file.empty()) {
+            std::cerr << "ERROR: --resume needs the checkpoint file given with --checkpoint. Exiting." << endl;
+            std::exit(-1);
+        }
+        conf.resume_from_checkpoint = true;
+    }
+
+    if (!conf.checkpoint_file.empty()) {
+        if (conf.preprocess != 0 || cube_depth > 0 || vm.count("drat")) {
+            std::cerr << "ERROR: checkpointing cannot be combined with preprocessing, cubing or DRAT. Exiting." << endl;
+            std::exit(-1);
+        }
+        if (conf.doCompHandler) {
+            conf.doCompHandler = false;
+            if (conf.verbosity) {
+                cout << "c Cannot handle components when checkpointing. Turning it off." << endl;
+            }
+        }
+        if (num_threads > 1) {
+            num_threads = 1;
+            cout << "c Cannot handle multiple threads when checkpointing. Setting to 1." << endl;
+        }
+
+        //Interrupting writes a last checkpoint
+        need_clean_exit = 1;
+    }
+
+    if (!conf.sync_net_listen.empty() || !conf.sync_net_connect.empty()) {
+        if (!conf.sync_net_listen.empty() && !conf.sync_net_connect.empty()) {
+            std::cerr << "ERROR: Only one of --syncserve and --syncconnect can be given. Exiting." << endl;
+            std::exit(-1);
+        }
+        if (vm.count("drat")) {
+            std::cerr << "ERROR: DRAT cannot be combined with sharing clauses between processes. Exiting." << endl;
+            std::exit(-1);
+        }
+    }
+
     if (vm.count("dumpresult")) {
         resultfile = new std::ofstream;
         resultfile->open(resultFilename.c_str());
@@ -1419,7 +1511,7 @@ int Main::solve()
 
     //Parse in DIMACS (maybe gzipped) files
     //solver->log_to_file("mydump.cnf");
-    if (conf.preprocess != 2) {
+    if (conf.preprocess != 2 && !conf.resume_from_checkpoint) {
         parseInAllFiles(solver);
     }
     if (!assump_filename.empty()) {
@@ -1464,6 +1556,7 @@ lbool Main::multi_solutions()
 {
     if (max_nr_of_solutions == 1
         && conf.preprocess == 0
+        && cube_depth == 0
         && dratf == NULL
         && !conf.simulate_drat
         && debugLib.empty()
@@ -1474,7 +1567,11 @@ lbool Main::multi_solutions()
     unsigned long current_nr_of_solutions = 0;
     lbool ret = l_True;
     while(current_nr_of_solutions < max_nr_of_solutions && ret == l_True) {
-        ret = solver->solve(&assumps, only_sampling_solution);
+        if (cube_depth > 0) {
+            ret = solver->solve_cubes(cube_depth, &assumps);
+        } else {
+            ret = solver->solve(&assumps, only_sampling_solution);
+        }
         current_nr_of_solutions++;
 
         if (ret == l_True && current_nr_of_solutions < max_nr_of_solutions) {
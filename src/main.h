@@ -113,6 +113,9 @@ class Main: public MainCommon
         string sqlite_filename;
         double maxtime;
         uint64_t maxconfl;
+        unsigned cube_depth = 0;
+        int mmap_parse = true;
+        unsigned parse_threads = 0;
 
         //Sampling vars
         vector<uint32_t> sampling_vars;
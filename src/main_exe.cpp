@@ -42,6 +42,10 @@ int main(int argc, char** argv)
         main.parseCommandLine();
 
         signal(SIGINT, SIGINT_handler);
+        if (!main.conf.checkpoint_file.empty()) {
+            //Preemption usually sends SIGTERM
+            signal(SIGTERM, SIGINT_handler);
+        }
         ret = main.solve();
     } catch (CMSat::TooManyVarsError& e) {
         std::cerr << "ERROR! Variable requested is far too large" << std::endl;
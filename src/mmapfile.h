@@ -0,0 +1,118 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef MMAPFILE_H
+#define MMAPFILE_H
+
+#include <string>
+#include <cstddef>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CMSat {
+
+//Read-only view of a whole file. open() fails (and the caller should fall
+//back to StreamBuffer) if the platform has no mmap, the file is not a regular
+//file (pipes, stdin) or it is gzip-compressed.
+class MMapFile
+{
+public:
+    MMapFile() = default;
+    MMapFile(const MMapFile&) = delete;
+    MMapFile& operator=(const MMapFile&) = delete;
+    ~MMapFile()
+    {
+        close();
+    }
+
+    bool open(const std::string& fname)
+    {
+        close();
+        #if defined(_WIN32)
+        (void)fname;
+        return false;
+        #else
+        int fd = ::open(fname.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (ptr == MAP_FAILED) {
+            return false;
+        }
+        sz = st.st_size;
+        ptr_start = (const char*)ptr;
+
+        //gzip magic
+        if (sz >= 2
+            && (unsigned char)ptr_start[0] == 0x1f
+            && (unsigned char)ptr_start[1] == 0x8b
+        ) {
+            close();
+            return false;
+        }
+        madvise(ptr, sz, MADV_SEQUENTIAL);
+        return true;
+        #endif
+    }
+
+    void close()
+    {
+        #if !defined(_WIN32)
+        if (ptr_start) {
+            munmap((void*)ptr_start, sz);
+        }
+        #endif
+        ptr_start = NULL;
+        sz = 0;
+    }
+
+    const char* data() const
+    {
+        return ptr_start;
+    }
+
+    size_t size() const
+    {
+        return sz;
+    }
+
+private:
+    const char* ptr_start = NULL;
+    size_t sz = 0;
+};
+
+}
+
+#endif //MMAPFILE_H
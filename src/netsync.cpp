@@ -0,0 +1,464 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "netsync.h"
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using std::cout;
+using std::endl;
+using namespace CMSat;
+
+//Everything on the wire is a 32b word, in network byte order.
+//Every peer first sends a hello: magic, number of variables, and the hash
+//of the formula, high word first. Then clauses: size, glue, lits
+static const uint32_t hello_magic = 0x434d5332;
+static const uint32_t hello_words = 4;
+static const uint32_t max_msg_size = 1000;
+static const size_t max_out_size = 16ULL*1024ULL*1024ULL;
+static const uint32_t connect_tries = 100;
+
+#ifdef MSG_NOSIGNAL
+static const int send_flags = MSG_NOSIGNAL;
+#else
+static const int send_flags = 0;
+#endif
+
+//Nothing more to do now, try again next time
+static bool would_block()
+{
+    #if EAGAIN == EWOULDBLOCK
+    return errno == EAGAIN || errno == EINTR;
+    #else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    #endif
+}
+
+static int open_socket(
+    const string& addr
+    , const bool serve
+    , string& unix_path
+) {
+    int fd = -1;
+    if (addr.compare(0, 5, "unix:") == 0) {
+        const string path = addr.substr(5);
+        sockaddr_un sa;
+        memset(&sa, 0, sizeof(sa));
+        if (path.empty() || path.size() >= sizeof(sa.sun_path)) {
+            std::cerr << "ERROR: Bad unix socket path: '" << path << "'" << endl;
+            std::exit(-1);
+        }
+        sa.sun_family = AF_UNIX;
+        memcpy(sa.sun_path, path.c_str(), path.size());
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        if (serve) {
+            unlink(path.c_str());
+            if (bind(fd, (sockaddr*)&sa, sizeof(sa)) != 0) {
+                close(fd);
+                return -1;
+            }
+            unix_path = path;
+        } else if (connect(fd, (sockaddr*)&sa, sizeof(sa)) != 0) {
+            close(fd);
+            return -1;
+        }
+    } else if (addr.compare(0, 4, "tcp:") == 0) {
+        const string host_port = addr.substr(4);
+        const size_t colon = host_port.rfind(':');
+        string host;
+        string port = host_port;
+        if (colon != string::npos) {
+            host = host_port.substr(0, colon);
+            port = host_port.substr(colon+1);
+        }
+        if (host.size() >= 2 && host[0] == '[' && host[host.size()-1] == ']') {
+            host = host.substr(1, host.size()-2);
+        }
+        if (port.empty() || (host.empty() && !serve)) {
+            std::cerr << "ERROR: Bad TCP address: '" << addr << "'" << endl;
+            std::exit(-1);
+        }
+        //Listening on other interfaces must be asked for
+        if (host.empty()) {
+            host = "127.0.0.1";
+        }
+
+        addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* res = NULL;
+        const int err = getaddrinfo(host.c_str(), port.c_str(), &hints, &res);
+        if (err != 0) {
+            std::cerr << "ERROR: Cannot resolve '" << addr << "': "
+            << gai_strerror(err) << endl;
+            std::exit(-1);
+        }
+
+        for(addrinfo* ai = res; ai != NULL && fd < 0; ai = ai->ai_next) {
+            fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+            if (serve) {
+                int one = 1;
+                setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+                if (bind(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+                    close(fd);
+                    fd = -1;
+                }
+            } else if (connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(res);
+    } else {
+        std::cerr << "ERROR: Address must be 'unix:PATH' or 'tcp:HOST:PORT', not '"
+        << addr << "'" << endl;
+        std::exit(-1);
+    }
+
+    if (fd >= 0) {
+        #ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+        #endif
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    return fd;
+}
+
+NetSync::NetSync(
+    const string& addr
+    , const bool serve
+    , const uint32_t _nVars
+    , const uint64_t _formula_hash
+    , const int _verbosity
+) :
+    nVars(_nVars)
+    , formula_hash(_formula_hash)
+    , verbosity(_verbosity)
+{
+    if (serve) {
+        listen_fd = open_socket(addr, true, unix_path);
+        if (listen_fd < 0 || ::listen(listen_fd, 64) != 0) {
+            std::cerr << "ERROR: Cannot listen on '" << addr << "': "
+            << strerror(errno) << endl;
+            std::exit(-1);
+        }
+        if (verbosity) {
+            cout << "c [netsync] listening on " << addr << endl;
+        }
+        return;
+    }
+
+    //The listening process may not be up yet
+    int fd = -1;
+    for(uint32_t i = 0; i < connect_tries && fd < 0; i++) {
+        fd = open_socket(addr, false, unix_path);
+        if (fd < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    if (fd < 0) {
+        cout << "c WARNING: [netsync] could not connect to " << addr
+        << ", not sharing clauses with other processes" << endl;
+        return;
+    }
+    add_peer(fd);
+    if (verbosity) {
+        cout << "c [netsync] connected to " << addr << endl;
+    }
+}
+
+NetSync::~NetSync()
+{
+    for(Peer& p: peers) {
+        close_peer(p);
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+    }
+    if (!unix_path.empty()) {
+        unlink(unix_path.c_str());
+    }
+}
+
+void NetSync::add_peer(const int fd)
+{
+    peers.push_back(Peer());
+    peers.back().fd = fd;
+    const uint32_t hello[hello_words] = {
+        hello_magic
+        , nVars
+        , (uint32_t)(formula_hash >> 32)
+        , (uint32_t)formula_hash
+    };
+    queue_msg(peers.back(), hello, hello_words);
+}
+
+void NetSync::close_peer(Peer& p)
+{
+    if (p.fd >= 0) {
+        close(p.fd);
+        p.fd = -1;
+    }
+}
+
+uint32_t NetSync::num_peers() const
+{
+    uint32_t num = 0;
+    for(const Peer& p: peers) {
+        num += (p.fd >= 0);
+    }
+    return num;
+}
+
+uint16_t NetSync::get_listen_port() const
+{
+    sockaddr_storage sa;
+    socklen_t len = sizeof(sa);
+    if (listen_fd < 0
+        || getsockname(listen_fd, (sockaddr*)&sa, &len) != 0
+    ) {
+        return 0;
+    }
+    if (sa.ss_family == AF_INET) {
+        return ntohs(((sockaddr_in*)&sa)->sin_port);
+    }
+    if (sa.ss_family == AF_INET6) {
+        return ntohs(((sockaddr_in6*)&sa)->sin6_port);
+    }
+    return 0;
+}
+
+void NetSync::queue_msg(Peer& p, const uint32_t* words, const uint32_t num)
+{
+    if (p.fd < 0) {
+        return;
+    }
+    if (p.out.size() - p.out_at > max_out_size) {
+        lost++;
+        return;
+    }
+    for(uint32_t i = 0; i < num; i++) {
+        const uint32_t w = htonl(words[i]);
+        const char* c = (const char*)&w;
+        p.out.insert(p.out.end(), c, c + sizeof(uint32_t));
+    }
+}
+
+void NetSync::send(const vector<Lit>& lits, const uint32_t glue)
+{
+    assert(!lits.empty() && lits.size() <= max_msg_size);
+    tmp.clear();
+    tmp.push_back(lits.size());
+    tmp.push_back(glue);
+    for(const Lit l: lits) {
+        tmp.push_back(l.toInt());
+    }
+    for(Peer& p: peers) {
+        queue_msg(p, tmp.data(), tmp.size());
+    }
+}
+
+void NetSync::accept_peers()
+{
+    if (listen_fd < 0) {
+        return;
+    }
+    while(true) {
+        const int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        #ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+        #endif
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        add_peer(fd);
+        if (verbosity) {
+            cout << "c [netsync] new peer, num peers: " << num_peers() << endl;
+        }
+    }
+}
+
+bool NetSync::send_out(Peer& p)
+{
+    while(p.out_at < p.out.size()) {
+        const ssize_t ret = ::send(
+            p.fd, p.out.data() + p.out_at, p.out.size() - p.out_at, send_flags);
+        if (ret < 0) {
+            return would_block();
+        }
+        p.out_at += ret;
+    }
+    p.out.clear();
+    p.out_at = 0;
+    return true;
+}
+
+static uint32_t read_word(const char* at)
+{
+    uint32_t w;
+    memcpy(&w, at, sizeof(uint32_t));
+    return ntohl(w);
+}
+
+//Reads all that's there from peers[from], and passes every clause to the
+//other peers, too
+bool NetSync::recv_in(const size_t from)
+{
+    vector<char>& in = peers[from].in;
+    char buf[1<<16];
+    while(true) {
+        const ssize_t ret = ::recv(peers[from].fd, buf, sizeof(buf), 0);
+        if (ret == 0) {
+            return false;
+        }
+        if (ret < 0) {
+            if (would_block()) {
+                break;
+            }
+            return false;
+        }
+        in.insert(in.end(), buf, buf + ret);
+    }
+
+    size_t at = 0;
+    if (!peers[from].got_hello) {
+        if (in.size() < hello_words*sizeof(uint32_t)) {
+            return true;
+        }
+        const uint32_t magic = read_word(in.data());
+        const uint32_t other_nVars = read_word(in.data() + sizeof(uint32_t));
+        const uint64_t other_hash =
+            ((uint64_t)read_word(in.data() + 2*sizeof(uint32_t)) << 32)
+            | read_word(in.data() + 3*sizeof(uint32_t));
+        if (magic != hello_magic || other_nVars != nVars) {
+            cout << "c WARNING: [netsync] dropping peer: not a solver or"
+            << " different number of variables (" << other_nVars
+            << " vs " << nVars << ")" << endl;
+            return false;
+        }
+        if (other_hash != formula_hash) {
+            cout << "c WARNING: [netsync] dropping peer: it is solving"
+            << " a different formula" << endl;
+            return false;
+        }
+        peers[from].got_hello = true;
+        at += hello_words*sizeof(uint32_t);
+    }
+
+    while(in.size() - at >= 2*sizeof(uint32_t)) {
+        const uint32_t sz = read_word(in.data() + at);
+        if (sz == 0 || sz > max_msg_size) {
+            return false;
+        }
+        const size_t msg_bytes = (2+sz)*sizeof(uint32_t);
+        if (in.size() - at < msg_bytes) {
+            break;
+        }
+
+        tmp.clear();
+        for(uint32_t i = 0; i < 2+sz; i++) {
+            tmp.push_back(read_word(in.data() + at + i*sizeof(uint32_t)));
+        }
+        at += msg_bytes;
+
+        recvd.insert(recvd.end(), tmp.begin(), tmp.end());
+        for(size_t i = 0; i < peers.size(); i++) {
+            if (i != from) {
+                queue_msg(peers[i], tmp.data(), tmp.size());
+            }
+        }
+    }
+    in.erase(in.begin(), in.begin() + at);
+
+    return true;
+}
+
+void NetSync::exchange()
+{
+    accept_peers();
+
+    for(size_t i = 0; i < peers.size(); i++) {
+        if (peers[i].fd >= 0 && !recv_in(i)) {
+            close_peer(peers[i]);
+            if (verbosity) {
+                cout << "c [netsync] peer left, num peers: " << num_peers() << endl;
+            }
+        }
+    }
+
+    for(Peer& p: peers) {
+        if (p.fd >= 0 && !send_out(p)) {
+            close_peer(p);
+        }
+    }
+
+    peers.erase(
+        std::remove_if(peers.begin(), peers.end(),
+            [](const Peer& p) {return p.fd < 0;})
+        , peers.end());
+}
+
+bool NetSync::get(vector<Lit>& lits, uint32_t& glue)
+{
+    if (recvd_at == recvd.size()) {
+        recvd.clear();
+        recvd_at = 0;
+        return false;
+    }
+
+    const uint32_t sz = recvd[recvd_at];
+    glue = recvd[recvd_at+1];
+    lits.resize(sz);
+    for(uint32_t i = 0; i < sz; i++) {
+        lits[i] = Lit::toLit(recvd[recvd_at+2+i]);
+    }
+    recvd_at += 2+sz;
+    return true;
+}
@@ -0,0 +1,116 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef NETSYNC_H
+#define NETSYNC_H
+
+#include "cryptominisat5/solvertypesmini.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+using std::vector;
+using std::string;
+
+namespace CMSat {
+
+/**
+@brief Exchanges short clauses with other solver processes over sockets
+
+The processes form a star: one of them listens, the others connect to it.
+The listening one forwards everything it receives from a process to all the
+others. Addresses are either "unix:PATH" or "tcp:HOST:PORT". When listening,
+HOST can be left out ("tcp:PORT") to listen on 127.0.0.1 only;
+to listen on all interfaces, give "tcp:0.0.0.0:PORT" or "tcp:[::]:PORT".
+
+Clauses are in the outside numbering, without BVA variables. All processes
+must be solving the same problem: the number of variables and the hash of
+the clauses added before solving (Solver::get_input_hash()) are checked
+when connecting. Peers are not authenticated, anyone who can connect can
+send clauses, so only listen where all who can connect are trusted.
+
+Nothing blocks, except connecting to the listening process at startup.
+Whatever doesn't fit into the send buffer of a slow peer is lost.
+*/
+class NetSync
+{
+    public:
+        NetSync(
+            const string& addr
+            , const bool serve
+            , const uint32_t nVars
+            , const uint64_t formula_hash
+            , const int verbosity
+        );
+        ~NetSync();
+        NetSync(const NetSync&) = delete;
+        NetSync& operator=(const NetSync&) = delete;
+
+        void send(const vector<Lit>& lits, const uint32_t glue);
+
+        ///Accepts new peers, sends what it can and receives what's there
+        void exchange();
+
+        ///Next clause received, false if there are no more
+        bool get(vector<Lit>& lits, uint32_t& glue);
+
+        ///The port actually listened on, when given port 0
+        uint16_t get_listen_port() const;
+        uint32_t num_peers() const;
+        uint64_t get_num_lost() const
+        {
+            return lost;
+        }
+
+    private:
+        struct Peer {
+            int fd = -1;
+            bool got_hello = false;
+            vector<char> out;
+            size_t out_at = 0;
+            vector<char> in;
+        };
+        void add_peer(const int fd);
+        void queue_msg(Peer& p, const uint32_t* words, const uint32_t num);
+        bool send_out(Peer& p);
+        bool recv_in(const size_t from);
+        void close_peer(Peer& p);
+        void accept_peers();
+
+        vector<Peer> peers;
+        int listen_fd = -1;
+        string unix_path; ///<to be removed when done listening
+        uint32_t nVars;
+        uint64_t formula_hash;
+        int verbosity;
+
+        //Received, not yet got: size, glue, lits...
+        vector<uint32_t> recvd;
+        size_t recvd_at = 0;
+
+        vector<uint32_t> tmp;
+        uint64_t lost = 0;
+};
+
+}
+
+#endif //NETSYNC_H
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <limits>
 #include <cmath>
 #include <functional>
+#include <thread>
 
 
 #include "popcnt.h"
@@ -92,6 +93,7 @@ OccSimplifier::OccSimplifier(Solver* _solver):
     , seen2(solver->seen2)
     , toClear(solver->toClear)
     , velim_order(VarOrderLt(varElimComplexity))
+    , elim_ctx(solver->seen)
     , topLevelGauss(NULL)
     //, gateFinder(NULL)
     , anythingHasBeenBlocked(false)
@@ -961,6 +963,7 @@ bool OccSimplifier::eliminate_vars()
     assert(solver->watches.get_smudged_list().empty());
     bvestats.clear();
     bvestats.numCalls = 1;
+    setup_elim_workers();
 
     //Go through the ordered list of variables to eliminate
     int64_t last_elimed = 1;
@@ -1027,6 +1030,13 @@ bool OccSimplifier::eliminate_vars()
                 && !solver->must_interrupt_asap()
             ) {
                 assert(limit_to_decrease == &norm_varelim_time_limit);
+                if (elim_threads > 1) {
+                    if (!eliminate_vars_batch(vars_elimed, wenThrough, last_elimed)) {
+                        goto end;
+                    }
+                    continue;
+                }
+
                 uint32_t var = velim_order.removeMin();
 
                 //Stats
@@ -1046,20 +1056,9 @@ bool OccSimplifier::eliminate_vars()
                 if (!solver->ok)
                     goto end;
 
-                //SUB and STR for long and short
-                limit_to_decrease = &varelim_sub_str_limit;
-                if (!deal_with_added_long_and_bin(false)) {
-                    limit_to_decrease = &norm_varelim_time_limit;
+                if (!clean_up_after_varelim()) {
                     goto end;
                 }
-                limit_to_decrease = &norm_varelim_time_limit;
-
-                solver->ok = solver->propagate_occur();
-                if (!solver->okay()) {
-                    goto end;
-                }
-
-                update_varelim_complexity_heap();
             }
 
             //Clean clauses that have vars that have been set
@@ -1174,6 +1173,7 @@ bool OccSimplifier::eliminate_vars()
 
 end:
     free_clauses_to_free();
+    free_elim_workers();
     const double time_used = cpuTime() - myTime;
     const bool time_out = (*limit_to_decrease <= 0);
     const double time_remain = float_div(*limit_to_decrease, orig_norm_varelim_time_limit);
@@ -1181,7 +1181,13 @@ end:
     if (solver->conf.verbosity) {
         cout
         << "c  #try to eliminate: "<< print_value_kilo_mega(wenThrough) << endl
-        << "c  #var-elim        : "<< print_value_kilo_mega(vars_elimed) << endl
+        << "c  #var-elim        : "<< print_value_kilo_mega(vars_elimed) << endl;
+        if (elim_threads > 1) {
+            cout
+            << "c  #threads         : " << elim_threads << endl
+            << "c  #redone seq      : "<< print_value_kilo_mega(elim_batch_redone) << endl;
+        }
+        cout
         << "c  #T-o: " << (time_out ? "Y" : "N") << endl
         << "c  #T-r: " << std::fixed << std::setprecision(2) << (time_remain*100.0) << "%" << endl
         << "c  #T  : " << time_used << endl;
@@ -1211,6 +1217,261 @@ end:
     return solver->okay();
 }
 
+bool OccSimplifier::clean_up_after_varelim()
+{
+    //SUB and STR for long and short
+    limit_to_decrease = &varelim_sub_str_limit;
+    if (!deal_with_added_long_and_bin(false)) {
+        limit_to_decrease = &norm_varelim_time_limit;
+        return false;
+    }
+    limit_to_decrease = &norm_varelim_time_limit;
+
+    solver->ok = solver->propagate_occur();
+    if (!solver->okay()) {
+        return false;
+    }
+
+    update_varelim_complexity_heap();
+    return true;
+}
+
+//Number of candidates picked off velim_order at once by parallel BVE. Fixed,
+//so the result does not depend on the number of threads.
+static const size_t elim_batch_size = 256;
+
+void OccSimplifier::setup_elim_workers()
+{
+    elim_threads = solver->conf.varelim_threads;
+    if (elim_threads == 0) {
+        elim_threads = num_cpus_available();
+    }
+    elim_batch_redone = 0;
+    if (elim_threads == 1) {
+        return;
+    }
+
+    for(uint32_t i = 1; i < elim_threads; i++) {
+        elim_workers.push_back(new ElimWorker(solver->seen.size()));
+    }
+}
+
+void OccSimplifier::free_elim_workers()
+{
+    for(ElimWorker* w: elim_workers) {
+        delete w;
+    }
+    elim_workers.clear();
+    elim_batch.clear();
+    elim_batch.shrink_to_fit();
+}
+
+//Irredundant clauses of var, independent of their order in the watchlists.
+//Tells if test_elim_and_fill_resolvents() could give a different answer now.
+uint64_t OccSimplifier::occ_signature(const uint32_t var) const
+{
+    uint64_t sig = 0;
+    for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+        for(const Watched& w: solver->watches[lit]) {
+            uint64_t h;
+            if (w.isBin()) {
+                if (w.red()) {
+                    continue;
+                }
+                h = lit.toInt() + ((uint64_t)w.lit2().toInt() << 32);
+            } else if (w.isClause()) {
+                const Clause* cl = solver->cl_alloc.ptr(w.get_offset());
+                if (cl->red() || cl->getRemoved() || cl->freed()) {
+                    continue;
+                }
+                h = w.get_offset();
+                for(const Lit l: *cl) {
+                    h = (h ^ l.toInt()) * 0x100000001b3ULL;
+                }
+            } else {
+                continue;
+            }
+            h ^= h >> 31;
+            h *= 0x9E3779B97F4A7C15ULL;
+            h ^= h >> 29;
+            sig += h;
+        }
+    }
+    return sig;
+}
+
+//Marks all variables that share a clause with var. A later candidate that
+//is not marked has no clause in common with any earlier one.
+void OccSimplifier::lock_vars_of_elim_candidate(const uint32_t var)
+{
+    auto lock = [&](const uint32_t v) {
+        if (!seen2[Lit(v, false).toInt()]) {
+            seen2[Lit(v, false).toInt()] = 1;
+            elim_locked.push_back(v);
+        }
+    };
+
+    lock(var);
+    for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+        for(const Watched& w: solver->watches[lit]) {
+            if (w.isBin()) {
+                lock(w.lit2().var());
+            } else if (w.isClause()) {
+                const Clause* cl = solver->cl_alloc.ptr(w.get_offset());
+                if (cl->getRemoved() || cl->freed()) {
+                    continue;
+                }
+                for(const Lit l: *cl) {
+                    lock(l.var());
+                }
+            }
+        }
+    }
+}
+
+void OccSimplifier::elim_batch_worker(
+    ElimCtx* ctx
+    , const size_t num
+    , std::atomic<size_t>* at
+    , const int64_t budget
+) {
+    for(size_t i = (*at)++; i < num; i = (*at)++) {
+        ElimCandidate& c = elim_batch[i];
+        if (!c.eval) {
+            continue;
+        }
+
+        int64_t limit = budget;
+        ctx->limit = &limit;
+        c.ret = test_elim_and_fill_resolvents(c.var, *ctx);
+        c.cost = budget - limit;
+        c.sig = occ_signature(c.var);
+        std::swap(c.resolvents, ctx->resolvents);
+    }
+}
+
+//Parallel BVE. Takes the next candidates off velim_order, keeping only the
+//ones that share no clause with an earlier kept one, and calculates their
+//resolvents in parallel. Their clauses are disjoint, so the workers only
+//read the clause database, and each writes only the watchlists (sorting)
+//and gate marks of its own variable.
+//
+//The results are applied one by one, in heap order, exactly like the
+//sequential loop does. If an earlier elimination in the batch (or the
+//subsumption and propagation after it) changed a candidate's clauses, that
+//candidate is re-done sequentially.
+bool OccSimplifier::eliminate_vars_batch(
+    size_t& vars_elimed
+    , size_t& wenThrough
+    , int64_t& last_elimed
+) {
+    //Pick independent candidates
+    size_t num = 0;
+    elim_deferred.clear();
+    while(!velim_order.empty()
+        && num < elim_batch_size
+        && elim_deferred.size() < elim_batch_size
+    ) {
+        const uint32_t var = velim_order.removeMin();
+        const bool eval = can_eliminate_var(var);
+        if (eval) {
+            if (seen2[Lit(var, false).toInt()]) {
+                elim_deferred.push_back(var);
+                continue;
+            }
+            lock_vars_of_elim_candidate(var);
+        }
+        if (elim_batch.size() <= num) {
+            elim_batch.resize(num+1);
+        }
+        ElimCandidate& c = elim_batch[num++];
+        c.var = var;
+        c.eval = eval;
+    }
+    for(const uint32_t v: elim_locked) {
+        seen2[Lit(v, false).toInt()] = 0;
+    }
+    elim_locked.clear();
+
+    //Calculate resolvents
+    const int64_t budget = *limit_to_decrease;
+    std::atomic<size_t> at(0);
+    vector<std::thread> thds;
+    const size_t num_thds = std::min<size_t>(elim_threads, num);
+    for(size_t i = 1; i < num_thds; i++) {
+        thds.push_back(std::thread(
+            &OccSimplifier::elim_batch_worker, this
+            , &elim_workers[i-1]->ctx, num, &at, budget));
+    }
+    elim_batch_worker(&elim_ctx, num, &at, budget);
+    for(std::thread& t: thds) {
+        t.join();
+    }
+
+    //Apply them, in order
+    const size_t orig_trail_size = solver->trail_size();
+    size_t i = 0;
+    for(; i < num; i++) {
+        if (*limit_to_decrease <= 0
+            || varelim_num_limit <= 0
+            || varelim_linkin_limit_bytes <= 0
+            || solver->must_interrupt_asap()
+        ) {
+            break;
+        }
+
+        ElimCandidate& c = elim_batch[i];
+        *limit_to_decrease -= 20;
+        wenThrough++;
+        if (!can_eliminate_var(c.var)) {
+            continue;
+        }
+
+        elim_calc_need_update.clear();
+        bool elimed;
+        if (solver->trail_size() != orig_trail_size
+            || occ_signature(c.var) != c.sig
+        ) {
+            elim_batch_redone++;
+            elimed = maybe_eliminate(c.var);
+        } else {
+            print_var_elim_complexity_stats(c.var);
+            bvestats.testedToElimVars++;
+            *limit_to_decrease -= c.cost;
+            elimed = (c.ret <= 0 && *limit_to_decrease >= 0);
+            if (elimed) {
+                eliminate_with_resolvents(c.var, c.resolvents);
+            }
+        }
+        if (elimed) {
+            vars_elimed++;
+            varelim_num_limit--;
+            last_elimed++;
+        }
+        if (!solver->ok) {
+            return false;
+        }
+
+        if (!clean_up_after_varelim()) {
+            return false;
+        }
+    }
+
+    //Put back the ones not tried. Their score wasn't updated while outside
+    for(; i < num; i++) {
+        elim_deferred.push_back(elim_batch[i].var);
+    }
+    for(const uint32_t var: elim_deferred) {
+        if (!can_eliminate_var(var) || velim_order.inHeap(var)) {
+            continue;
+        }
+        varElimComplexity[var] = heuristicCalcVarElimScore(var);
+        velim_order.insert(var);
+    }
+
+    return true;
+}
+
 void OccSimplifier::free_clauses_to_free()
 {
     for(ClOffset off: cl_to_free_later) {
@@ -2286,12 +2547,13 @@ void OccSimplifier::find_gate(
     Lit elim_lit
     , watch_subarray_const a
     , watch_subarray_const b
+    , ElimCtx& ctx
 ) {
-    assert(toClear.empty());
+    assert(ctx.toClear.empty());
     for(const Watched w: a) {
         if (w.isBin() && !w.red()) {
-            seen[(~w.lit2()).toInt()] = 1;
-            toClear.push_back(~w.lit2());
+            ctx.seen[(~w.lit2()).toInt()] = 1;
+            ctx.toClear.push_back(~w.lit2());
         }
     }
 
@@ -2312,7 +2574,7 @@ void OccSimplifier::find_gate(
                 bool OK = true;
                 for(const Lit lit: *cl) {
                     if (lit != ~elim_lit) {
-                        if (!seen[lit.toInt()]) {
+                        if (!ctx.seen[lit.toInt()]) {
                             OK = false;
                             break;
                         }
@@ -2322,35 +2584,36 @@ void OccSimplifier::find_gate(
                 //Found all lits inside
                 if (OK) {
                     cl->stats.marked_clause = true;
-                    gate_varelim_clause = cl;
+                    ctx.gate_varelim_clause = cl;
                     break;
                 }
             }
         }
     }
 
-    for(Lit l: toClear) {
-        seen[l.toInt()] = 0;
+    for(Lit l: ctx.toClear) {
+        ctx.seen[l.toInt()] = 0;
     }
-    toClear.clear();
+    ctx.toClear.clear();
 }
 
 void OccSimplifier::mark_gate_in_poss_negs(
     Lit elim_lit
     , watch_subarray_const poss
     , watch_subarray_const negs
+    , ElimCtx& ctx
 ) {
     //Either of the two is OK. Let's just find ONE, not the biggest one.
     //We could find the biggest one, but it's expensive.
     bool found_pos = false;
-    gate_varelim_clause = NULL;
-    find_gate(elim_lit, poss, negs);
-    if (gate_varelim_clause == NULL) {
-        find_gate(~elim_lit, negs, poss);
+    ctx.gate_varelim_clause = NULL;
+    find_gate(elim_lit, poss, negs, ctx);
+    if (ctx.gate_varelim_clause == NULL) {
+        find_gate(~elim_lit, negs, poss, ctx);
         found_pos = true;
     }
 
-    if (gate_varelim_clause != NULL && solver->conf.verbosity >= 10) {
+    if (ctx.gate_varelim_clause != NULL && solver->conf.verbosity >= 10) {
         cout
         << "Lit: " << elim_lit
         << " gate_found_elim_pos:" << found_pos
@@ -2358,7 +2621,7 @@ void OccSimplifier::mark_gate_in_poss_negs(
     }
 }
 
-int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
+int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var, ElimCtx& ctx)
 {
     assert(solver->ok);
     assert(solver->varData[var].removed == Removed::none);
@@ -2383,7 +2646,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
     const uint32_t neg = n_occurs[Lit(var, true).toInt()];
 
     //Heuristic calculation took too much time
-    if (*limit_to_decrease < 0) {
+    if (*ctx.limit < 0) {
         return std::numeric_limits<int>::max();
     }
 
@@ -2393,7 +2656,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
     watch_subarray negs = solver->watches[~lit];
     std::sort(poss.begin(), poss.end(), watch_sort_smallest_first());
     std::sort(negs.begin(), negs.end(), watch_sort_smallest_first());
-    resolvents.clear();
+    ctx.resolvents.clear();
 
     //Pure literal, no resolvents
     //we look at "pos" and "neg" (and not poss&negs) because we don't care about redundant clauses
@@ -2408,9 +2671,9 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         return std::numeric_limits<int>::max();
     }
 
-    gate_varelim_clause = NULL;
+    ctx.gate_varelim_clause = NULL;
     if (solver->conf.skip_some_bve_resolvents) {
-        mark_gate_in_poss_negs(lit, poss, negs);
+        mark_gate_in_poss_negs(lit, poss, negs, ctx);
     }
 
     // Count clauses/literals after elimination
@@ -2422,7 +2685,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         ; it != end
         ; ++it, at_poss++
     ) {
-        *limit_to_decrease -= 3;
+        *ctx.limit -= 3;
         if (solver->redundant_or_removed(*it))
             continue;
 
@@ -2431,22 +2694,22 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             ; it2 != end2
             ; it2++, at_negs++
         ) {
-            *limit_to_decrease -= 3;
+            *ctx.limit -= 3;
             if (solver->redundant_or_removed(*it2))
                 continue;
 
             //Resolve the two clauses
-            bool tautological = resolve_clauses(*it, *it2, lit);
+            bool tautological = resolve_clauses(*it, *it2, lit, ctx);
             if (tautological) {
                 continue;
             }
 
-            if (solver->satisfied_cl(dummy)) {
+            if (solver->satisfied_cl(ctx.dummy)) {
                 continue;
             }
 
             #ifdef VERBOSE_DEBUG_VARELIM
-            cout << "Adding new clause due to varelim: " << dummy << endl;
+            cout << "Adding new clause due to varelim: " << ctx.dummy << endl;
             #endif
 
             after_clauses++;
@@ -2454,13 +2717,13 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             if (after_clauses > (before_clauses + grow)
                 //Too long resolvent
                 || (solver->conf.velim_resolvent_too_large != -1
-                    && ((int)dummy.size() > solver->conf.velim_resolvent_too_large))
+                    && ((int)ctx.dummy.size() > solver->conf.velim_resolvent_too_large))
                 //Over-time
-                || *limit_to_decrease < -10LL*1000LL
+                || *ctx.limit < -10LL*1000LL
 
             ) {
-                if (gate_varelim_clause) {
-                    gate_varelim_clause->stats.marked_clause = false;
+                if (ctx.gate_varelim_clause) {
+                    ctx.gate_varelim_clause->stats.marked_clause = false;
                 }
                 return std::numeric_limits<int>::max();
             }
@@ -2485,12 +2748,12 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             }
             //must clear marking that has been set due to gate
             stats.marked_clause = 0;
-            resolvents.add_resolvent(dummy, stats, is_xor);
+            ctx.resolvents.add_resolvent(ctx.dummy, stats, is_xor);
         }
     }
 
-    if (gate_varelim_clause) {
-        gate_varelim_clause->stats.marked_clause = false;
+    if (ctx.gate_varelim_clause) {
+        ctx.gate_varelim_clause->stats.marked_clause = false;
     }
 
     return -1;
@@ -2681,16 +2944,25 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
     assert(solver->ok);
     print_var_elim_complexity_stats(var);
     bvestats.testedToElimVars++;
-    const Lit lit = Lit(var, false);
 
     //Heuristic says no, or we ran out of time
-    if (test_elim_and_fill_resolvents(var) > 0
+    elim_ctx.limit = limit_to_decrease;
+    if (test_elim_and_fill_resolvents(var, elim_ctx) > 0
         || *limit_to_decrease < 0
     ) {
         return false;  //didn't eliminate :(
     }
-    bvestats.triedToElimVars++;
 
+    eliminate_with_resolvents(var, elim_ctx.resolvents);
+    return true; //eliminated!
+}
+
+//Replaces the clauses of 'var' with 'res', as calculated by
+//test_elim_and_fill_resolvents()
+void OccSimplifier::eliminate_with_resolvents(const uint32_t var, Resolvents& res)
+{
+    bvestats.triedToElimVars++;
+    const Lit lit = Lit(var, false);
     print_var_eliminate_stat(lit);
 
     //Remove clauses
@@ -2699,41 +2971,40 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
     rem_cls_from_watch_due_to_varelim(solver->watches[~lit], ~lit);
 
     //Add resolvents
-    while(!resolvents.empty()) {
-        if (!add_varelim_resolvent(resolvents.back_lits(),
-            resolvents.back_stats(), resolvents.back_xor())
+    while(!res.empty()) {
+        if (!add_varelim_resolvent(res.back_lits(),
+            res.back_stats(), res.back_xor())
         ) {
             goto end;
         }
-        resolvents.pop();
+        res.pop();
     }
     limit_to_decrease = &norm_varelim_time_limit;
 
 end:
     set_var_as_eliminated(var, lit);
-
-    return true; //eliminated!
 }
 
 void OccSimplifier::add_pos_lits_to_dummy_and_seen(
     const Watched ps
     , const Lit posLit
+    , ElimCtx& ctx
 ) {
     if (ps.isBin()) {
-        *limit_to_decrease -= 1;
+        *ctx.limit -= 1;
         assert(ps.lit2() != posLit);
 
-        seen[ps.lit2().toInt()] = 1;
-        dummy.push_back(ps.lit2());
+        ctx.seen[ps.lit2().toInt()] = 1;
+        ctx.dummy.push_back(ps.lit2());
     }
 
     if (ps.isClause()) {
         Clause& cl = *solver->cl_alloc.ptr(ps.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        *ctx.limit -= (long)cl.size()/2;
         for (const Lit lit : cl){
             if (lit != posLit) {
-                seen[lit.toInt()] = 1;
-                dummy.push_back(lit);
+                ctx.seen[lit.toInt()] = 1;
+                ctx.dummy.push_back(lit);
             }
         }
     }
@@ -2742,34 +3013,35 @@ void OccSimplifier::add_pos_lits_to_dummy_and_seen(
 bool OccSimplifier::add_neg_lits_to_dummy_and_seen(
     const Watched qs
     , const Lit posLit
+    , ElimCtx& ctx
 ) {
     if (qs.isBin()) {
-        *limit_to_decrease -= 1;
+        *ctx.limit -= 1;
         assert(qs.lit2() != ~posLit);
 
-        if (seen[(~qs.lit2()).toInt()]) {
+        if (ctx.seen[(~qs.lit2()).toInt()]) {
             return true;
         }
-        if (!seen[qs.lit2().toInt()]) {
-            dummy.push_back(qs.lit2());
-            seen[qs.lit2().toInt()] = 1;
+        if (!ctx.seen[qs.lit2().toInt()]) {
+            ctx.dummy.push_back(qs.lit2());
+            ctx.seen[qs.lit2().toInt()] = 1;
         }
     }
 
     if (qs.isClause()) {
         Clause& cl = *solver->cl_alloc.ptr(qs.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        *ctx.limit -= (long)cl.size()/2;
         for (const Lit lit: cl) {
             if (lit == ~posLit)
                 continue;
 
-            if (seen[(~lit).toInt()]) {
+            if (ctx.seen[(~lit).toInt()]) {
                 return true;
             }
 
-            if (!seen[lit.toInt()]) {
-                dummy.push_back(lit);
-                seen[lit.toInt()] = 1;
+            if (!ctx.seen[lit.toInt()]) {
+                ctx.dummy.push_back(lit);
+                ctx.seen[lit.toInt()] = 1;
             }
         }
     }
@@ -2781,6 +3053,7 @@ bool OccSimplifier::resolve_clauses(
     const Watched ps
     , const Watched qs
     , const Lit posLit
+    , ElimCtx& ctx
 ) {
     //If clause has already been freed, skip
     Clause *cl1 = NULL;
@@ -2798,7 +3071,7 @@ bool OccSimplifier::resolve_clauses(
             return true;
         }
     }
-    if (gate_varelim_clause
+    if (ctx.gate_varelim_clause
         && cl1 && cl2
         && !cl1->stats.marked_clause
         && !cl2->stats.marked_clause
@@ -2813,13 +3086,13 @@ bool OccSimplifier::resolve_clauses(
         return true;
     }
 
-    dummy.clear();
-    add_pos_lits_to_dummy_and_seen(ps, posLit);
-    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit);
+    ctx.dummy.clear();
+    add_pos_lits_to_dummy_and_seen(ps, posLit, ctx);
+    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit, ctx);
 
-    *limit_to_decrease -= (long)dummy.size()/2 + 1;
-    for (const Lit lit: dummy) {
-        seen[lit.toInt()] = 0;
+    *ctx.limit -= (long)ctx.dummy.size()/2 + 1;
+    for (const Lit lit: ctx.dummy) {
+        ctx.seen[lit.toInt()] = 0;
     }
 
     return tautological;
@@ -3152,7 +3425,7 @@ void OccSimplifier::check_elimed_vars_are_unassignedAndStats() const
 size_t OccSimplifier::mem_used() const
 {
     size_t b = 0;
-    b += dummy.capacity()*sizeof(char);
+    b += elim_ctx.dummy.capacity()*sizeof(Lit);
     b += added_long_cl.capacity()*sizeof(ClOffset);
     b += sub_str->mem_used();
     b += blockedClauses.capacity()*sizeof(BlockedClauses);
@@ -3317,6 +3590,7 @@ void OccSimplifier::save_state(SimpleOutFile& f)
     }
     f.put_vector(blkcls);
     f.put_struct(globalStats);
+    f.put_struct(bvestats_global);
     f.put_uint32_t(anythingHasBeenBlocked);
 
 
@@ -3331,6 +3605,7 @@ void OccSimplifier::load_state(SimpleInFile& f)
     }
     f.get_vector(blkcls);
     f.get_struct(globalStats);
+    f.get_struct(bvestats_global);
     anythingHasBeenBlocked = f.get_uint32_t();
 
     blockedMapBuilt = false;
@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include <map>
 #include <iomanip>
 #include <fstream>
+#include <atomic>
 
 #include "clause.h"
 #include "solvertypes.h"
@@ -323,8 +324,6 @@ private:
     vector<Lit>& toClear;
     vector<bool> sampling_vars_occsimp;
 
-    //Temporaries
-    vector<Lit>     dummy;       ///<Used by merge()
 
     //Time Limits
     uint64_t clause_lits_added;
@@ -439,13 +438,16 @@ private:
     TouchList   elim_calc_need_update;
     vector<ClOffset> cl_to_free_later;
     bool        maybe_eliminate(const uint32_t x);
+    struct      ElimCtx;
+    struct      Resolvents;
+    void        eliminate_with_resolvents(const uint32_t var, Resolvents& res);
     bool        deal_with_added_long_and_bin(const bool main);
     bool        prop_and_clean_long_and_impl_clauses();
     vector<Lit> tmp_bin_cl;
     void        create_dummy_blocked_clause(const Lit lit);
-    int         test_elim_and_fill_resolvents(uint32_t var);
-    void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs);
-    void        find_gate(Lit elim_lit, watch_subarray_const a, watch_subarray_const b);
+    int         test_elim_and_fill_resolvents(uint32_t var, ElimCtx& ctx);
+    void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs, ElimCtx& ctx);
+    void        find_gate(Lit elim_lit, watch_subarray_const a, watch_subarray_const b, ElimCtx& ctx);
     void        print_var_eliminate_stat(Lit lit) const;
     bool        add_varelim_resolvent(vector<Lit>& finalLits, const ClauseStats& stats, bool is_xor);
     void        update_varelim_complexity_heap();
@@ -503,8 +505,53 @@ private:
             return at;
         }
     };
-    Resolvents resolvents;
-    Clause* gate_varelim_clause;
+
+    //Scratch space of test_elim_and_fill_resolvents(). The sequential BVE
+    //uses elim_ctx, every parallel BVE worker has its own.
+    struct ElimCtx {
+        explicit ElimCtx(vector<uint16_t>& _seen) :
+            seen(_seen)
+        {}
+
+        vector<uint16_t>& seen;
+        vector<Lit> toClear;
+        vector<Lit> dummy;
+        Resolvents resolvents;
+        Clause* gate_varelim_clause = NULL;
+        int64_t* limit = NULL;
+    };
+    ElimCtx elim_ctx;
+
+    //Parallel BVE, see eliminate_vars_batch()
+    struct ElimCandidate {
+        uint32_t var;
+        bool eval; //could be eliminated when it was picked
+        int ret;
+        int64_t cost;
+        uint64_t sig;
+        Resolvents resolvents;
+    };
+    struct ElimWorker {
+        explicit ElimWorker(size_t num_lits) :
+            seen(num_lits, 0)
+            , ctx(seen)
+        {}
+        vector<uint16_t> seen;
+        ElimCtx ctx;
+    };
+    vector<ElimCandidate> elim_batch;
+    vector<ElimWorker*> elim_workers;
+    vector<uint32_t> elim_locked;
+    vector<uint32_t> elim_deferred;
+    uint32_t elim_threads = 1;
+    size_t elim_batch_redone = 0;
+    bool eliminate_vars_batch(size_t& vars_elimed, size_t& wenThrough, int64_t& last_elimed);
+    void elim_batch_worker(ElimCtx* ctx, size_t num, std::atomic<size_t>* at, int64_t budget);
+    void lock_vars_of_elim_candidate(const uint32_t var);
+    uint64_t occ_signature(const uint32_t var) const;
+    bool clean_up_after_varelim();
+    void setup_elim_workers();
+    void free_elim_workers();
     uint32_t calc_data_for_heuristic(const Lit lit);
     uint64_t time_spent_on_calc_otf_update;
     uint64_t num_otf_update_until_now;
@@ -527,14 +574,17 @@ private:
         const Watched ps
         , const Watched qs
         , const Lit noPosLit
+        , ElimCtx& ctx
     );
     void add_pos_lits_to_dummy_and_seen(
         const Watched ps
         , const Lit posLit
+        , ElimCtx& ctx
     );
     bool add_neg_lits_to_dummy_and_seen(
         const Watched qs
         , const Lit posLit
+        , ElimCtx& ctx
     );
     bool eliminate_vars();
     void eliminate_empty_resolvent_vars();
@@ -0,0 +1,423 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef ORDERHEAP_H
+#define ORDERHEAP_H
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "heap.h"
+#include "solvertypes.h"
+
+namespace CMSat {
+
+using std::vector;
+
+///Order variables according to their activities
+struct VarOrderLt {
+    const vector<ActAndOffset>&  activities;
+    bool operator () (const uint32_t x, const uint32_t y) const
+    {
+        return activities[x].combine() > activities[y].combine();
+    }
+
+    explicit VarOrderLt(const vector<ActAndOffset>& _activities) :
+        activities(_activities)
+    {}
+};
+
+//4-ary max-heap of variables, ordered by activity. The activity is kept
+//next to the variable, so comparisons don't go through the activities
+//array, and the 4 children of a node are in one 64-byte cache line: the
+//buffer is 64-byte aligned and the root is in slot 3, so the children of
+//slot p are slots 4p-8..4p-5, which start at a multiple of 4 slots.
+//
+//The inline keys are copies: whenever an activity changes, the variable
+//must be given to decrease()/increase()/update(), or, when all activities
+//were scaled, refresh_keys() must be called.
+class ActHeap {
+    struct Elem {
+        double key;
+        uint32_t var;
+    };
+    static_assert(sizeof(Elem) == 16, "4 heap elements must fill a cache line");
+
+    static const int root = 3;
+    static const size_t line_bytes = 64;
+
+    const vector<ActAndOffset>& activities;
+    Elem* heap = NULL; //Slots [0, root) are unused
+    int sz = 0;
+    int cap = 0; //Slots allocated, including the unused ones
+    vec<int> indices; //Each var's slot in the heap, -1 if not in it
+
+    static inline int first_child(int p)
+    {
+        return p * 4 - 8;
+    }
+    static inline int parent(int p)
+    {
+        return (p + 8) >> 2;
+    }
+    int end() const
+    {
+        return root + sz;
+    }
+
+    void grow_to(const int num)
+    {
+        if (root + num <= cap) {
+            return;
+        }
+        int new_cap = std::max(cap*2, root + num);
+        new_cap = (new_cap + 3) & ~3;
+        const size_t bytes = (size_t)new_cap*sizeof(Elem);
+
+        Elem* new_heap;
+        #ifdef _WIN32
+        new_heap = (Elem*)_aligned_malloc(bytes, line_bytes);
+        #else
+        if (posix_memalign((void**)&new_heap, line_bytes, bytes) != 0) {
+            new_heap = NULL;
+        }
+        #endif
+        if (new_heap == NULL) {
+            throw std::bad_alloc();
+        }
+        if (heap != NULL) {
+            memcpy(new_heap, heap, (size_t)end()*sizeof(Elem));
+        }
+        free_heap();
+        heap = new_heap;
+        cap = new_cap;
+    }
+
+    void free_heap()
+    {
+        #ifdef _WIN32
+        _aligned_free(heap);
+        #else
+        free(heap);
+        #endif
+        heap = NULL;
+        cap = 0;
+    }
+
+    void percolateUp(int i)
+    {
+        const Elem x = heap[i];
+        while (i != root) {
+            const int p = parent(i);
+            if (!(x.key > heap[p].key)) {
+                break;
+            }
+            heap[i] = heap[p];
+            indices[heap[i].var] = i;
+            i = p;
+        }
+        heap[i] = x;
+        indices[x.var] = i;
+    }
+
+    void percolateDown(int i)
+    {
+        const Elem x = heap[i];
+        const int e = end();
+        for(;;) {
+            const int c = first_child(i);
+            if (c >= e) {
+                break;
+            }
+            int best = c;
+            const int last = std::min(c + 4, e);
+            for(int k = c + 1; k < last; k++) {
+                if (heap[k].key > heap[best].key) {
+                    best = k;
+                }
+            }
+            if (!(heap[best].key > x.key)) {
+                break;
+            }
+            heap[i] = heap[best];
+            indices[heap[i].var] = i;
+            i = best;
+        }
+        heap[i] = x;
+        indices[x.var] = i;
+    }
+
+    void refresh_key(int n)
+    {
+        heap[indices[n]].key = activities[n].combine();
+    }
+
+public:
+    explicit ActHeap(const vector<ActAndOffset>& _activities) :
+        activities(_activities)
+    {}
+    ~ActHeap()
+    {
+        free_heap();
+    }
+    ActHeap(const ActHeap&) = delete;
+    ActHeap& operator=(const ActHeap&) = delete;
+
+    void print_heap() {
+        std::cout << "heap:";
+        for(int i = root; i < end(); i++) {
+            std::cout << heap[i].var << " ";
+        }
+        std::cout << std::endl;
+
+        std::cout << "ind:";
+        for(auto x: indices) {
+            std::cout << x << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    uint32_t size() const
+    {
+        return sz;
+    }
+    bool empty() const
+    {
+        return sz == 0;
+    }
+    bool inHeap(int n) const
+    {
+        return n < (int)indices.size() && indices[n] >= 0;
+    }
+    int operator[](int index) const
+    {
+        assert(index < sz);
+        return heap[root + index].var;
+    }
+    int random_element(MTRand& rnd)
+    {
+        assert(!empty());
+        return heap[root + rnd.randInt(sz-1)].var;
+    }
+
+    //Activity went up
+    void decrease(int n)
+    {
+        assert(inHeap(n));
+        refresh_key(n);
+        percolateUp(indices[n]);
+    }
+    //Activity went down
+    void increase(int n)
+    {
+        assert(inHeap(n));
+        refresh_key(n);
+        percolateDown(indices[n]);
+    }
+
+    void update(int n)
+    {
+        if (!inHeap(n)) {
+            insert(n);
+        } else {
+            refresh_key(n);
+            percolateUp(indices[n]);
+            percolateDown(indices[n]);
+        }
+    }
+
+    void insert(int n)
+    {
+        indices.growTo(n + 1, -1);
+        assert(!inHeap(n));
+
+        grow_to(sz + 1);
+        indices[n] = end();
+        heap[end()] = Elem{activities[n].combine(), (uint32_t)n};
+        sz++;
+        percolateUp(indices[n]);
+    }
+
+    //Removes the variable with the highest activity
+    int removeMin()
+    {
+        const int x = heap[root].var;
+        heap[root] = heap[end()-1];
+        indices[heap[root].var] = root;
+        indices[x] = -1;
+        sz--;
+        if (sz > 1) {
+            percolateDown(root);
+        }
+        return x;
+    }
+
+    template<typename T>
+    void build(const T& ns)
+    {
+        clear();
+        grow_to(ns.size());
+        for (uint32_t i = 0; i < ns.size(); i++) {
+            indices.growTo(ns[i] + 1, -1);
+            indices[ns[i]] = end();
+            heap[end()] = Elem{activities[ns[i]].combine(), ns[i]};
+            sz++;
+        }
+
+        for (int i = parent(end() - 1); i >= root; i--) {
+            percolateDown(i);
+        }
+    }
+
+    //Scaling all activities by the same factor keeps the order
+    void refresh_keys()
+    {
+        for(int i = root; i < end(); i++) {
+            heap[i].key = activities[heap[i].var].combine();
+        }
+    }
+
+    void clear(bool dealloc = false)
+    {
+        for (int i = root; i < end(); i++) {
+            indices[heap[i].var] = -1;
+        }
+        sz = 0;
+        if (dealloc) {
+            free_heap();
+        }
+    }
+
+    size_t mem_used() const
+    {
+        size_t mem = 0;
+        mem += (size_t)cap*sizeof(Elem);
+        mem += indices.capacity()*sizeof(int);
+        return mem;
+    }
+
+    bool heap_property() const
+    {
+        for(int i = root + 1; i < end(); i++) {
+            if (heap[i].key > heap[parent(i)].key) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+//The branching heap: either the binary Heap that looks up activities
+//through VarOrderLt, or the 4-ary ActHeap, as per SolverConf::order_heap_4ary.
+//Chosen once, at construction.
+class OrderHeap {
+    Heap<VarOrderLt> bin;
+    ActHeap dary;
+    const bool use_dary;
+
+public:
+    OrderHeap(const vector<ActAndOffset>& activities, const bool _use_dary) :
+        bin(VarOrderLt(activities))
+        , dary(activities)
+        , use_dary(_use_dary)
+    {}
+
+    void print_heap()
+    {
+        if (use_dary) dary.print_heap();
+        else bin.print_heap();
+    }
+    uint32_t size() const
+    {
+        return use_dary ? dary.size() : bin.size();
+    }
+    bool empty() const
+    {
+        return use_dary ? dary.empty() : bin.empty();
+    }
+    bool inHeap(int n) const
+    {
+        return use_dary ? dary.inHeap(n) : bin.inHeap(n);
+    }
+    int operator[](int index) const
+    {
+        return use_dary ? dary[index] : bin[index];
+    }
+    int random_element(MTRand& rnd)
+    {
+        return use_dary ? dary.random_element(rnd) : bin.random_element(rnd);
+    }
+    void decrease(int n)
+    {
+        if (use_dary) dary.decrease(n);
+        else bin.decrease(n);
+    }
+    void increase(int n)
+    {
+        if (use_dary) dary.increase(n);
+        else bin.increase(n);
+    }
+    void update(int n)
+    {
+        if (use_dary) dary.update(n);
+        else bin.update(n);
+    }
+    void insert(int n)
+    {
+        if (use_dary) dary.insert(n);
+        else bin.insert(n);
+    }
+    int removeMin()
+    {
+        return use_dary ? dary.removeMin() : bin.removeMin();
+    }
+    template<typename T>
+    void build(const T& ns)
+    {
+        if (use_dary) dary.build(ns);
+        else bin.build(ns);
+    }
+    void refresh_keys()
+    {
+        if (use_dary) dary.refresh_keys();
+    }
+    void clear(bool dealloc = false)
+    {
+        if (use_dary) dary.clear(dealloc);
+        else bin.clear(dealloc);
+    }
+    size_t mem_used() const
+    {
+        return bin.mem_used() + dary.mem_used();
+    }
+    bool heap_property() const
+    {
+        return use_dary ? dary.heap_property() : bin.heap_property();
+    }
+};
+
+}
+
+#endif //ORDERHEAP_H
@@ -61,10 +61,13 @@ uint32_t PackedRow::find_watchVar(
     non_resp_var = std::numeric_limits<uint32_t>::max();
     tmp_clause.clear();
 
-    for(int i = 0; i < size*64; i++) {
-        if (this->operator[](i)){
+    for(int i = next_nonzero_word(0); i < size; i = next_nonzero_word(i+1)) {
+        uint64_t tmp = mp[i];
+        while (tmp) {
+            const uint32_t col = i*64 + scan_fwd_64b(tmp)-1;
+            tmp &= tmp-1;
             popcnt++;
-            uint32_t var = col_to_var[i];
+            uint32_t var = col_to_var[col];
             tmp_clause.push_back(Lit(var, false));
 
             if (!var_has_resp_row[var]) {
@@ -149,7 +152,10 @@ gret PackedRow::propGause(
 
     //Find new watch
     if (pop >= 2) {
-        for (int i = 0; i < size; i++) if (tmp_col.mp[i]) {
+        for (int i = tmp_col.next_nonzero_word(0)
+            ; i < size
+            ; i = tmp_col.next_nonzero_word(i+1)
+        ) {
             int64_t tmp = tmp_col.mp[i];
             unsigned long at;
             at = scan_fwd_64b(tmp);
@@ -57,6 +57,30 @@ inline void SetBit(int64_t *array, int bit) {
 
 */
 
+//Word-level kernels of the hot row operations. The best set the CPU supports
+//is picked once at startup, see packedrow_simd.cpp
+struct PackedRowKernels
+{
+    const char* name;
+
+    //a ^= b
+    void (*xor_in)(int64_t* __restrict a, const int64_t* __restrict b, int num);
+
+    //out = a & b, may stop (and return) once the popcount is at least 2
+    uint32_t (*set_and_until_popcnt_atleast2)(
+        int64_t* __restrict out, const int64_t* a, const int64_t* b, int num);
+
+    //First index at or after 'from' with a non-zero word, or 'num'
+    int (*find_nonzero)(const int64_t* p, int from, int num);
+};
+extern PackedRowKernels row_kernels;
+
+//All kernel sets this CPU can run, the portable one first
+vector<PackedRowKernels> available_row_kernels();
+
+//Rows shorter than this are faster with the inlined loops than with a call
+static const int row_kernel_min_words = 4;
+
 class PackedRow
 {
 public:
@@ -139,6 +163,10 @@ public:
         assert(b.size == size);
         #endif
 
+        if (size >= row_kernel_min_words) {
+            return row_kernels.set_and_until_popcnt_atleast2(mp, a.mp, b.mp, size);
+        }
+
         uint32_t pop = 0;
         for (int i = 0; i < size && pop < 2; i++) {
             *(mp + i) = *(a.mp + i) & *(b.mp + i);
@@ -157,6 +185,10 @@ public:
         #endif
 
         rhs_internal ^= b.rhs_internal;
+        if (size >= row_kernel_min_words) {
+            row_kernels.xor_in(mp, b.mp, size);
+            return;
+        }
         for (int i = 0; i < size; i++) {
             *(mp + i) ^= *(b.mp + i);
         }
@@ -180,6 +212,18 @@ public:
         return true;
     }
 
+    //Index of the first non-zero word at or after 'from', or 'size'
+    inline int next_nonzero_word(int from) const
+    {
+        if (size >= row_kernel_min_words) {
+            return row_kernels.find_nonzero(mp, from, size);
+        }
+        while (from < size && mp[from] == 0) {
+            from++;
+        }
+        return from;
+    }
+
     inline void setZero()
     {
         memset(mp, 0, sizeof(int64_t)*size);
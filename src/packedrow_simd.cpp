@@ -0,0 +1,153 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "packedrow.h"
+
+//Kernels for wider vector units are compiled with target attributes, so the
+//rest of the library stays runnable on plain x86-64. Which ones are used is
+//decided at startup via __builtin_cpu_supports()
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CMS_ROW_SIMD_X86
+#include <immintrin.h>
+#endif
+
+using namespace CMSat;
+
+//
+// Portable kernels
+//
+
+static void xor_in_generic(int64_t* __restrict a, const int64_t* __restrict b, int num)
+{
+    for (int i = 0; i < num; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+static uint32_t set_and_until_popcnt_atleast2_generic(
+    int64_t* __restrict out, const int64_t* a, const int64_t* b, int num)
+{
+    uint32_t pop = 0;
+    for (int i = 0; i < num && pop < 2; i++) {
+        out[i] = a[i] & b[i];
+        pop += __builtin_popcountll((uint64_t)out[i]);
+    }
+    return pop;
+}
+
+static int find_nonzero_generic(const int64_t* p, int from, int num)
+{
+    while (from < num && p[from] == 0) {
+        from++;
+    }
+    return from;
+}
+
+#ifdef CMS_ROW_SIMD_X86
+
+//
+// AVX2, 4 words at a time
+//
+
+__attribute__((target("avx2")))
+static void xor_in_avx2(int64_t* __restrict a, const int64_t* __restrict b, int num)
+{
+    int i = 0;
+    for (; i + 4 <= num; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a+i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b+i));
+        _mm256_storeu_si256((__m256i*)(a+i), _mm256_xor_si256(x, y));
+    }
+    for (; i < num; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+//Stops after the 4-word block that got the popcount to 2. The words written
+//are the same as the generic version's, there may just be more of them.
+__attribute__((target("avx2,popcnt")))
+static uint32_t set_and_until_popcnt_atleast2_avx2(
+    int64_t* __restrict out, const int64_t* a, const int64_t* b, int num)
+{
+    uint32_t pop = 0;
+    int i = 0;
+    for (; i + 4 <= num; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a+i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b+i));
+        const __m256i z = _mm256_and_si256(x, y);
+        _mm256_storeu_si256((__m256i*)(out+i), z);
+        if (!_mm256_testz_si256(z, z)) {
+            pop += _mm_popcnt_u64(out[i]) + _mm_popcnt_u64(out[i+1])
+                + _mm_popcnt_u64(out[i+2]) + _mm_popcnt_u64(out[i+3]);
+            if (pop >= 2) {
+                return pop;
+            }
+        }
+    }
+    for (; i < num && pop < 2; i++) {
+        out[i] = a[i] & b[i];
+        pop += _mm_popcnt_u64(out[i]);
+    }
+    return pop;
+}
+
+__attribute__((target("avx2")))
+static int find_nonzero_avx2(const int64_t* p, int from, int num)
+{
+    for (; from + 4 <= num; from += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(p+from));
+        if (!_mm256_testz_si256(x, x)) {
+            const __m256i zero = _mm256_cmpeq_epi64(x, _mm256_setzero_si256());
+            const int zero_mask = _mm256_movemask_pd(_mm256_castsi256_pd(zero));
+            return from + __builtin_ctz(~zero_mask);
+        }
+    }
+    while (from < num && p[from] == 0) {
+        from++;
+    }
+    return from;
+}
+
+#endif //CMS_ROW_SIMD_X86
+
+vector<PackedRowKernels> CMSat::available_row_kernels()
+{
+    vector<PackedRowKernels> ret;
+    ret.push_back(PackedRowKernels{"generic"
+        , xor_in_generic
+        , set_and_until_popcnt_atleast2_generic
+        , find_nonzero_generic});
+
+    #ifdef CMS_ROW_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        ret.push_back(PackedRowKernels{"avx2"
+            , xor_in_avx2
+            , set_and_until_popcnt_atleast2_avx2
+            , find_nonzero_avx2});
+    }
+    #endif
+
+    return ret;
+}
+
+PackedRowKernels CMSat::row_kernels = available_row_kernels().back();
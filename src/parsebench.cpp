@@ -0,0 +1,160 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Measures DIMACS parsing throughput of the streaming and the mmap parser,
+//without any solver behind them:
+//
+//   make cms_parsebench && ./cms_parsebench [num_threads] file1.cnf ...
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+#include "cryptominisat5/solvertypesmini.h"
+#include "dimacsparser.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+using namespace CMSat;
+
+//Only counts and hashes what it's given
+struct NullSolver
+{
+    uint32_t nVars() const
+    {
+        return num_vars;
+    }
+
+    void new_var()
+    {
+        num_vars++;
+    }
+
+    void new_vars(const size_t n)
+    {
+        num_vars += n;
+    }
+
+    bool add_clause(const vector<Lit>& lits)
+    {
+        num_cls++;
+        for(const Lit l: lits) {
+            hash = hash*31 + l.toInt();
+        }
+        hash = hash*31 + 1;
+        return true;
+    }
+
+    bool add_xor_clause(const vector<uint32_t>& vars, bool rhs)
+    {
+        num_cls++;
+        for(const uint32_t v: vars) {
+            hash = hash*37 + v;
+        }
+        hash = hash*37 + rhs;
+        return true;
+    }
+
+    uint32_t num_vars = 0;
+    uint64_t num_cls = 0;
+    uint64_t hash = 0;
+};
+
+static double wall_time()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void print_result(
+    const char* name,
+    const NullSolver& s,
+    const double mb,
+    const double t)
+{
+    cout
+    << std::left << std::setw(12) << name << std::right
+    << " cls: " << std::setw(12) << s.num_cls
+    << " vars: " << std::setw(10) << s.num_vars
+    << " T: " << std::fixed << std::setprecision(3) << std::setw(8) << t
+    << " MB/s: " << std::setprecision(1) << std::setw(8) << (t > 0 ? mb/t : 0.0)
+    << " hash: " << std::hex << s.hash << std::dec
+    << endl;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " [num_threads] file1.cnf ..." << endl;
+        return -1;
+    }
+
+    int at = 1;
+    unsigned num_threads = 0;
+    if (argc > 2 && atoi(argv[1]) > 0) {
+        num_threads = atoi(argv[1]);
+        at++;
+    }
+
+    int ret = 0;
+    for(; at < argc; at++) {
+        const string fname = argv[at];
+        MMapFile mfile;
+        if (!mfile.open(fname)) {
+            cout << "ERROR: cannot mmap '" << fname << "'" << endl;
+            return -1;
+        }
+        const double mb = (double)mfile.size()/(1024.0*1024.0);
+        cout << "File: " << fname << " size: " << mb << " MB" << endl;
+
+        NullSolver s1;
+        FILE* in = fopen(fname.c_str(), "rb");
+        double t = wall_time();
+        DimacsParser<StreamBuffer<FILE*, FN>, NullSolver> p1(&s1, NULL, 0);
+        if (!p1.parse_DIMACS(in, false)) {
+            return -1;
+        }
+        print_result("stream", s1, mb, wall_time()-t);
+        fclose(in);
+
+        NullSolver s2;
+        t = wall_time();
+        DimacsParser<StreamBuffer<MemRange, MR>, NullSolver> p2(&s2, NULL, 0);
+        if (!p2.parse_DIMACS_mmap(mfile, false, num_threads)) {
+            return -1;
+        }
+        print_result("mmap", s2, mb, wall_time()-t);
+
+        if (s1.hash != s2.hash || s1.num_cls != s2.num_cls) {
+            cout << "ERROR: the two parsers disagree" << endl;
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,164 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "portfolio.h"
+
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+using namespace CMSat;
+
+//The values Solver::reconfigure() accepts
+static const int reconf_vals[] = {3, 4, 6, 7, 12, 13, 14, 15, 16};
+static const size_t num_reconf_vals = sizeof(reconf_vals)/sizeof(reconf_vals[0]);
+
+Portfolio::Portfolio(const uint32_t num_threads) :
+    threads(num_threads)
+    , last_decision(std::chrono::steady_clock::now())
+{
+}
+
+void Portfolio::set_initial_conf(const uint32_t tid, const int val)
+{
+    std::lock_guard<std::mutex> lock(mu);
+    assert(tid < threads.size());
+    threads[tid].conf_val = val;
+}
+
+int Portfolio::report(const uint32_t tid, const ThreadScore& score, const double period)
+{
+    std::lock_guard<std::mutex> lock(mu);
+    assert(tid < threads.size());
+    PerThread& t = threads[tid];
+    t.score = score;
+    t.num_reports++;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double>(now - last_decision).count() >= period) {
+        bool all_reported = true;
+        for(const PerThread& other: threads) {
+            if (other.num_reports == 0) {
+                all_reported = false;
+                break;
+            }
+        }
+        if (all_reported) {
+            decide();
+            last_decision = now;
+        }
+    }
+
+    //Its reports so far are about the old configuration
+    const int val = t.pending;
+    if (val != 0) {
+        t.pending = 0;
+        t.num_reports = 0;
+    }
+    return val;
+}
+
+void Portfolio::decide()
+{
+    const uint32_t weakest = find_weakest();
+    for(PerThread& t: threads) {
+        t.num_reports = 0;
+    }
+    if (weakest == 0) {
+        return;
+    }
+
+    const int val = pick_conf_for(weakest);
+    threads[weakest].conf_val = val;
+    threads[weakest].pending = val;
+    num_reconfs++;
+}
+
+//Returns 0 if no thread is clearly worse than the average
+uint32_t Portfolio::find_weakest() const
+{
+    const uint32_t n = threads.size();
+    if (n < 2) {
+        return 0;
+    }
+
+    //Sum of the ranks of each thread among all threads, by each score
+    vector<uint32_t> rank_sum(n, 0);
+    vector<uint32_t> order(n);
+    const double ThreadScore::* scores[] = {
+        &ThreadScore::confl_per_sec
+        , &ThreadScore::good_learnt_ratio
+        , &ThreadScore::trail_ratio
+        , &ThreadScore::imported_use
+    };
+    for(const auto score: scores) {
+        for(uint32_t i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+            [&](const uint32_t a, const uint32_t b) {
+                return threads[a].score.*score < threads[b].score.*score;
+        });
+        for(uint32_t i = 0; i < n; i++) {
+            rank_sum[order[i]] += i;
+        }
+    }
+
+    uint32_t weakest = 0;
+    for(uint32_t i = 1; i < n; i++) {
+        if (weakest == 0 || rank_sum[i] < rank_sum[weakest]) {
+            weakest = i;
+        }
+    }
+
+    //Average rank sum is 4*(n-1)/2
+    if (2*rank_sum[weakest] >= 4*(n-1)) {
+        return 0;
+    }
+    return weakest;
+}
+
+//The least used configuration, starting after the one the thread has now
+int Portfolio::pick_conf_for(const uint32_t tid) const
+{
+    size_t start = tid % num_reconf_vals;
+    for(size_t i = 0; i < num_reconf_vals; i++) {
+        if (reconf_vals[i] == threads[tid].conf_val) {
+            start = i+1;
+        }
+    }
+
+    int best = 0;
+    uint32_t best_used = std::numeric_limits<uint32_t>::max();
+    for(size_t k = 0; k < num_reconf_vals; k++) {
+        const int val = reconf_vals[(start + k) % num_reconf_vals];
+        uint32_t used = 0;
+        for(const PerThread& t: threads) {
+            used += (t.conf_val == val);
+        }
+        if (used < best_used) {
+            best = val;
+            best_used = used;
+        }
+    }
+    return best;
+}
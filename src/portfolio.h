@@ -0,0 +1,89 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+using std::vector;
+
+namespace CMSat {
+
+///How well a thread did during its last search iteration. Higher is better
+struct ThreadScore
+{
+    double confl_per_sec = 0;
+    double good_learnt_ratio = 0; ///<learnt clauses put in the lev0 (low glue) tier per conflict
+    double trail_ratio = 0; ///<longest trail over the number of variables
+    double imported_use = 0; ///<resolutions with imported clauses per imported clause
+};
+
+/**
+@brief Reconfigures the weakest threads of a multi-threaded run
+
+Every thread reports its ThreadScore after each search iteration. At most
+once every 'period' seconds (wall time), and only once every thread has
+reported since the last decision, the thread with the lowest sum of ranks
+over the scores is given a new Solver::reconfigure() value. It picks it up
+when it next reports. Thread 0, which runs the default configuration, is
+never reconfigured.
+*/
+class Portfolio
+{
+    public:
+        explicit Portfolio(const uint32_t num_threads);
+
+        ///The Solver::reconfigure() value thread 'tid' starts out closest to, or 0
+        void set_initial_conf(const uint32_t tid, const int val);
+
+        ///Returns the value to Solver::reconfigure() thread 'tid' to, or 0
+        int report(const uint32_t tid, const ThreadScore& score, const double period);
+
+        uint32_t get_num_reconfs() const
+        {
+            return num_reconfs;
+        }
+
+    private:
+        struct PerThread {
+            ThreadScore score;
+            uint32_t num_reports = 0; ///<since the last decision or its reconfiguration
+            int conf_val = 0;
+            int pending = 0;
+        };
+        void decide();
+        uint32_t find_weakest() const;
+        int pick_conf_for(const uint32_t tid) const;
+
+        std::mutex mu;
+        vector<PerThread> threads;
+        std::chrono::steady_clock::time_point last_decision;
+        uint32_t num_reconfs = 0;
+};
+
+}
+
+#endif //PORTFOLIO_H
@@ -37,6 +37,7 @@ enum PropByType {null_clause_t = 0, clause_t = 1, binary_t = 2
     #ifdef USE_GAUSS
     , xor_t = 3
     #endif
+    , shared_t = 4
 };
 
 class PropBy
@@ -44,12 +45,13 @@ class PropBy
     private:
         uint32_t red_step:1;
         uint32_t data1:31;
-        uint32_t type:2;
+        uint32_t type:3;
         //0: clause, NULL
         //1: clause, non-null
         //2: binary
-        //3: tertiary
-        uint32_t data2:30;
+        //3: xor
+        //4: clause of the SharedClauseDB
+        uint32_t data2:29;
 
     public:
         PropBy() :
@@ -82,6 +84,16 @@ class PropBy
         }
 #endif
 
+        //Clause of the SharedClauseDB
+        PropBy(const PropByType t, const uint32_t shared_idx) :
+            red_step(0)
+            , data1(shared_idx)
+            , type(shared_t)
+            , data2(0)
+        {
+            assert(t == shared_t);
+        }
+
         //Binary prop
         PropBy(const Lit lit, const bool redStep) :
             red_step(redStep)
@@ -184,6 +196,14 @@ class PropBy
             return data2;
         }
 
+        uint32_t get_shared_idx() const
+        {
+            #ifdef DEBUG_PROPAGATEFROM
+            assert(type == shared_t);
+            #endif
+            return data1;
+        }
+
         ClOffset get_offset() const
         {
             #ifdef DEBUG_PROPAGATEFROM
@@ -223,6 +243,10 @@ inline std::ostream& operator<<(std::ostream& os, const PropBy& pb)
             os << " clause, num= " << pb.get_offset();
             break;
 
+        case shared_t :
+            os << " shared clause, num= " << pb.get_shared_idx();
+            break;
+
         case null_clause_t :
             os << " NULL";
             break;
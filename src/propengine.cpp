@@ -55,8 +55,8 @@ PropEngine::PropEngine(
     , std::atomic<bool>* _must_interrupt_inter
 ) :
         CNF(_conf, _must_interrupt_inter)
-        , order_heap_vsids(VarOrderLt(var_act_vsids))
-        , order_heap_maple(VarOrderLt(var_act_maple))
+        , order_heap_vsids(var_act_vsids, conf.order_heap_4ary)
+        , order_heap_maple(var_act_maple, conf.order_heap_4ary)
         , qhead(0)
         , solver(_solver)
 {
@@ -226,6 +226,7 @@ bool PropEngine::prop_long_cl_any_order(
 
     // Did not find watch -- clause is unit under assignment:
     *j++ = *i;
+    c.inc_prop_uses();
     if (value(c[0]) == l_False) {
         handle_normal_prop_fail(c, offset, confl);
         return false;
@@ -248,7 +249,7 @@ bool PropEngine::prop_long_cl_any_order(
             uint32_t nMaxInd = 1;
             // pass over all the literals in the clause and find the one with the biggest level
             for (uint32_t nInd = 2; nInd < c.size(); ++nInd) {
-                uint32_t nLevel = varData[c[nInd].var()].level;
+                uint32_t nLevel = varLevel[c[nInd].var()];
                 if (nLevel > nMaxLevel) {
                     nMaxLevel = nLevel;
                     nMaxInd = nInd;
@@ -268,6 +269,208 @@ bool PropEngine::prop_long_cl_any_order(
     return true;
 }
 
+/**
+@brief Propagates a clause of the SharedClauseDB
+
+Same as the long clause case, but the clause can't be reordered, so the
+positions of its two watched literals are in shared_watched
+*/
+template<bool update_bogoprops>
+inline bool PropEngine::prop_shared_cl(
+    Watched* i
+    , Watched*& j
+    , const Lit p
+    , PropBy& confl
+    , uint32_t currLevel
+) {
+    const Lit blocked = i->getBlockedLit();
+    if (value(blocked) == l_True) {
+        *j++ = *i;
+        return true;
+    }
+    if (update_bogoprops) {
+        propStats.bogoProps += 4;
+    }
+
+    const uint32_t idx = i->get_shared_idx();
+    const Lit* lits = shared_cls_db->lits(idx);
+    const uint32_t size = shared_cls_db->cl_size(idx);
+    uint32_t* w = shared_watched.data() + 2*idx;
+    const Lit false_lit = ~p;
+    if (lits[w[0]] == false_lit) {
+        std::swap(w[0], w[1]);
+    }
+    assert(lits[w[1]] == false_lit);
+
+    const Lit first = lits[w[0]];
+    const Watched neww(watch_shared_t, idx, first);
+    if (first != blocked && value(first) == l_True) {
+        *j++ = neww;
+        return true;
+    }
+
+    // Look for new watch:
+    for (uint32_t k = 0; k < size; k++) {
+        if (k == w[0] || k == w[1]) {
+            continue;
+        }
+        if (value(lits[k]) != l_False) {
+            w[1] = k;
+            watches[lits[k]].push(neww);
+            return true;
+        }
+    }
+
+    // Did not find watch -- clause is unit under assignment:
+    *j++ = neww;
+    const PropBy reason(shared_t, idx);
+    if (value(first) == l_False) {
+        confl = reason;
+        #ifdef STATS_NEEDED
+        lastConflictCausedBy = ConflCausedBy::longirred;
+        #endif
+        qhead = trail.size();
+        return false;
+    }
+
+    #ifdef STATS_NEEDED
+    propStats.propsLongIrred++;
+    #endif
+    uint32_t nMaxLevel = currLevel;
+    if (currLevel != decisionLevel()) {
+        uint32_t nMaxInd = w[1];
+        for (uint32_t k = 0; k < size; k++) {
+            const uint32_t nLevel = varLevel[lits[k].var()];
+            if (k != w[0] && nLevel > nMaxLevel) {
+                nMaxLevel = nLevel;
+                nMaxInd = k;
+            }
+        }
+
+        if (nMaxInd != w[1]) {
+            w[1] = nMaxInd;
+            j--; // undo last watch
+            watches[lits[nMaxInd]].push(neww);
+        }
+    }
+    enqueue<update_bogoprops>(first, nMaxLevel, reason);
+
+    return true;
+}
+
+/**
+@brief Watches shared clause idx, at decision level 0
+
+Returns FALSE if all its literals are false. If only one is not, it's enqueued.
+*/
+bool PropEngine::attach_shared_clause(const uint32_t idx)
+{
+    assert(decisionLevel() == 0);
+    assert(shared_watched.size() == 2*idx);
+    const Lit* lits = shared_cls_db->lits(idx);
+    const uint32_t size = shared_cls_db->cl_size(idx);
+
+    uint32_t w[2];
+    uint32_t found = 0;
+    for (uint32_t k = 0; k < size && found < 2; k++) {
+        if (value(lits[k]) != l_False) {
+            w[found++] = k;
+        }
+    }
+    if (found == 0) {
+        return false;
+    }
+    if (found == 1) {
+        w[1] = (w[0] == 0) ? 1 : 0;
+        if (value(lits[w[0]]) == l_Undef) {
+            enqueue<true>(lits[w[0]]);
+        }
+    }
+
+    shared_watched.push_back(w[0]);
+    shared_watched.push_back(w[1]);
+    watches[lits[w[0]]].push(Watched(watch_shared_t, idx, lits[w[1]]));
+    watches[lits[w[1]]].push(Watched(watch_shared_t, idx, lits[w[0]]));
+    return true;
+}
+
+/**
+@brief Shared clause as a reason or conflict, for conflict analysis
+
+Puts the literal of first_var first. If it's var_Undef, the clause is a
+conflict and the literal of the highest level is put first.
+The result is only valid until the next call.
+*/
+const vector<Lit>& PropEngine::get_shared_cl(const PropBy pb, const uint32_t first_var)
+{
+    const uint32_t idx = pb.get_shared_idx();
+    const Lit* lits = shared_cls_db->lits(idx);
+    const uint32_t size = shared_cls_db->cl_size(idx);
+    shared_cl_tmp.assign(lits, lits + size);
+
+    uint32_t at = 0;
+    if (first_var == var_Undef) {
+        for (uint32_t k = 1; k < size; k++) {
+            if (varLevel[lits[k].var()] > varLevel[lits[at].var()]) {
+                at = k;
+            }
+        }
+    } else {
+        while (lits[at].var() != first_var) {
+            at++;
+            assert(at < size);
+        }
+    }
+    std::swap(shared_cl_tmp[0], shared_cl_tmp[at]);
+
+    return shared_cl_tmp;
+}
+
+/**
+@brief Watches the two highest-level literals of a conflicting shared clause
+
+With chronological backtracking the clause may be conflicting at a level
+below the current one, and after backtracking the watched literals must
+be the first ones to be unassigned. This is what find_conflict_level()
+does for normal clauses.
+*/
+void PropEngine::fix_shared_watches_for_confl(const uint32_t idx)
+{
+    const Lit* lits = shared_cls_db->lits(idx);
+    const uint32_t size = shared_cls_db->cl_size(idx);
+    uint32_t* w = shared_watched.data() + 2*idx;
+
+    uint32_t h0 = 0;
+    uint32_t h1 = 1;
+    if (varLevel[lits[h1].var()] > varLevel[lits[h0].var()]) {
+        std::swap(h0, h1);
+    }
+    for (uint32_t k = 2; k < size; k++) {
+        const uint32_t lev = varLevel[lits[k].var()];
+        if (lev > varLevel[lits[h0].var()]) {
+            h1 = h0;
+            h0 = k;
+        } else if (lev > varLevel[lits[h1].var()]) {
+            h1 = k;
+        }
+    }
+
+    const uint32_t lev0 = varLevel[lits[w[0]].var()];
+    const uint32_t lev1 = varLevel[lits[w[1]].var()];
+    if (std::max(lev0, lev1) == varLevel[lits[h0].var()]
+        && std::min(lev0, lev1) == varLevel[lits[h1].var()]
+    ) {
+        return;
+    }
+
+    removeWShared(watches[lits[w[0]]], idx);
+    removeWShared(watches[lits[w[1]]], idx);
+    w[0] = h0;
+    w[1] = h1;
+    watches[lits[h0]].push(Watched(watch_shared_t, idx, lits[h1]));
+    watches[lits[h1]].push(Watched(watch_shared_t, idx, lits[h0]));
+}
+
 PropBy PropEngine::propagate_any_order_fast()
 {
     PropBy confl;
@@ -325,6 +528,17 @@ PropBy PropEngine::propagate_any_order_fast()
                 continue;
             }
 
+            if (unlikely(i->isShared())) {
+                const bool ret = prop_shared_cl<false>(i, j, p, confl, currLevel);
+                i++;
+                if (!ret) {
+                    while (i < end) {
+                        *j++ = *i++;
+                    }
+                }
+                continue;
+            }
+
             //propagate normal clause
             //assert(i->isClause());
             Lit blocked = i->getBlockedLit();
@@ -374,6 +588,7 @@ PropBy PropEngine::propagate_any_order_fast()
 
             // Did not find watch -- clause is unit under assignment:
             *j++ = w;
+            c.inc_prop_uses();
             if (value(c[0]) == l_False) {
                 confl = PropBy(offset);
                 #ifdef STATS_NEEDED
@@ -407,7 +622,7 @@ PropBy PropEngine::propagate_any_order_fast()
                     uint32_t nMaxInd = 1;
                     // pass over all the literals in the clause and find the one with the biggest level
                     for (uint32_t nInd = 2; nInd < c.size(); ++nInd) {
-                        uint32_t nLevel = varData[c[nInd].var()].level;
+                        uint32_t nLevel = varLevel[c[nInd].var()];
                         if (nLevel > nMaxLevel) {
                             nMaxLevel = nLevel;
                             nMaxInd = nInd;
@@ -470,6 +685,14 @@ PropBy PropEngine::propagate_any_order()
                 continue;
             }
 
+            if (unlikely(i->isShared())) {
+                if (!prop_shared_cl<update_bogoprops>(i, j, p, confl, currLevel)) {
+                    i++;
+                    break;
+                }
+                continue;
+            }
+
             //propagate normal clause
             if (!prop_long_cl_any_order<update_bogoprops>(i, j, p, confl, currLevel)) {
                 i++;
@@ -515,6 +738,9 @@ void PropEngine::updateVars(
     const vector<uint32_t>& outerToInter
     , const vector<uint32_t>& interToOuter
 ) {
+    //Shared clauses are in outer numbering
+    assert(shared_cls_db == NULL);
+
     //Trail is NOT correct, only its length is correct
     for(Trail& t: trail) {
         t.lit = lit_Undef;
@@ -524,11 +750,11 @@ void PropEngine::updateVars(
 void PropEngine::print_trail()
 {
     for(size_t i = trail_lim[0]; i < trail.size(); i++) {
-        assert(varData[trail[i].lit.var()].level == trail[i].lev);
+        assert(varLevel[trail[i].lit.var()] == trail[i].lev);
         cout
         << "trail " << i << ":" << trail[i].lit
         << " lev: " << trail[i].lev
-        << " reason: " << varData[trail[i].lit.var()].reason
+        << " reason: " << varReason[trail[i].lit.var()]
         << endl;
     }
 }
@@ -632,6 +858,13 @@ void PropEngine::save_state(SimpleOutFile& f) const
 {
     f.put_vector(trail);
     f.put_uint32_t(qhead);
+    f.put_struct(var_decay);
+    f.put_struct(maple_step_size);
+    #ifdef VMTF_NEEDED
+    f.put_struct(vmtf_queue);
+    f.put_vector(vmtf_btab);
+    f.put_vector(vmtf_links);
+    #endif
 
     CNF::save_state(f);
 }
@@ -640,6 +873,13 @@ void PropEngine::load_state(SimpleInFile& f)
 {
     f.get_vector(trail);
     qhead = f.get_uint32_t();
+    f.get_struct(var_decay);
+    f.get_struct(maple_step_size);
+    #ifdef VMTF_NEEDED
+    f.get_struct(vmtf_queue);
+    f.get_vector(vmtf_btab);
+    f.get_vector(vmtf_links);
+    #endif
 
     CNF::load_state(f);
 }
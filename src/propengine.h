@@ -37,12 +37,13 @@ THE SOFTWARE.
 
 #include "avgcalc.h"
 #include "propby.h"
-#include "heap.h"
+#include "orderheap.h"
 #include "alg.h"
 #include "clause.h"
 #include "boundedqueue.h"
 #include "cnf.h"
 #include "watchalgos.h"
+#include "sharedclausedb.h"
 
 namespace CMSat {
 
@@ -131,20 +132,9 @@ public:
     double var_decay;
     double var_decay_max;
     double maple_step_size;
-    struct VarOrderLt { ///Order variables according to their activities
-        const vector<ActAndOffset>&  activities;
-        bool operator () (const uint32_t x, const uint32_t y) const
-        {
-            return activities[x].combine() > activities[y].combine();
-        }
-
-        explicit VarOrderLt(const vector<ActAndOffset>& _activities) :
-            activities(_activities)
-        {}
-    };
     ///activity-ordered heap of decision variables.
-    Heap<VarOrderLt> order_heap_vsids; ///NOT VALID WHILE SIMPLIFYING
-    Heap<VarOrderLt> order_heap_maple; ///NOT VALID WHILE SIMPLIFYING
+    OrderHeap order_heap_vsids; ///NOT VALID WHILE SIMPLIFYING
+    OrderHeap order_heap_maple; ///NOT VALID WHILE SIMPLIFYING
     #ifdef VMTF_NEEDED
     Queue vmtf_queue;
     vector<uint64_t> vmtf_btab; // enqueue time stamps for queue
@@ -159,6 +149,10 @@ public:
     //Clause activities
     double max_cl_act = 0.0;
 
+    //Long irred clauses that live in a SharedClauseDB, not in cl_alloc
+    const SharedClauseDB* shared_cls_db = NULL;
+    vector<uint32_t> shared_watched; ///<positions of the 2 watched lits of each shared clause
+
 protected:
     int64_t simpDB_props = 0;
     void new_var(const bool bva, const uint32_t orig_outer) override;
@@ -193,6 +187,11 @@ protected:
     );
     PropResult handle_normal_prop_fail(Clause& c, ClOffset offset, PropBy& confl);
 
+    //Shared clauses
+    bool attach_shared_clause(const uint32_t idx);
+    const vector<Lit>& get_shared_cl(const PropBy pb, const uint32_t first_var);
+    void fix_shared_watches_for_confl(const uint32_t idx);
+
     /////////////////
     // Operations on clauses:
     /////////////////
@@ -255,6 +254,7 @@ protected:
         mem += trail.capacity()*sizeof(Lit);
         mem += trail_lim.capacity()*sizeof(uint32_t);
         mem += toClear.capacity()*sizeof(Lit);
+        mem += shared_watched.capacity()*sizeof(uint32_t);
         return mem;
     }
 
@@ -277,6 +277,15 @@ private:
         , PropBy& confl
         , uint32_t currLevel
     );
+    template<bool update_bogoprops>
+    bool prop_shared_cl(
+        Watched* i
+        , Watched*& j
+        , const Lit p
+        , PropBy& confl
+        , uint32_t currLevel
+    );
+    vector<Lit> shared_cl_tmp;
     void sql_dump_vardata_picktime(uint32_t v, PropBy from);
 };
 
@@ -319,7 +328,7 @@ uint32_t PropEngine::calc_glue(const T& ps)
     MYFLAG++;
     uint32_t nblevels = 0;
     for (Lit lit: ps) {
-        int l = varData[lit.var()].level;
+        int l = varLevel[lit.var()];
         if (l != 0 && permDiff[l] != MYFLAG) {
             permDiff[l] = MYFLAG;
             nblevels++;
@@ -479,8 +488,8 @@ void PropEngine::enqueue(const Lit p, const uint32_t level, const PropBy from)
 
     const bool sign = p.sign();
     assigns[v] = boolToLBool(!sign);
-    varData[v].reason = from;
-    varData[v].level = level;
+    varReason[v] = from;
+    varLevel[v] = level;
     if (!update_bogoprops) {
         if (polarity_mode == PolarityMode::polarmode_automatic) {
             varData[v].polarity = !sign;
@@ -31,25 +31,11 @@ THE SOFTWARE.
 // #define VERBOSE_DEBUG
 
 #include <functional>
+#include <algorithm>
 #include <cmath>
 
 using namespace CMSat;
 
-struct SortRedClsGlue
-{
-    explicit SortRedClsGlue(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.glue < y->stats.glue;
-    }
-};
-
 struct SortRedClsSize
 {
     explicit SortRedClsSize(ClauseAllocator& _cl_alloc) :
@@ -139,30 +125,52 @@ ReduceDB::~ReduceDB()
     #endif
 }
 
-void ReduceDB::sort_red_cls(ClauseClean clean_type)
+//Only reads clause memory once: the keys of the clauses that can be removed
+//are put into red_cl_keys, and the top N are found via selection, not sorting
+void ReduceDB::fill_red_cl_keys()
 {
-    #ifdef VERBOSE_DEBUG
-    cout << "Before sort" << endl;
-    uint64_t i = 0;
-    for(const auto& x: solver->longRedCls[2]) {
-        const ClOffset offset = x;
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        cout << i << " offset: " << offset << " cl->stats.last_touched: " << cl->stats.last_touched
-        << " act:" << std::setprecision(9) << cl->stats.activity
-        << " which_red_array:" << cl->stats.which_red_array << endl
-        << " -- cl:" << *cl << " tern:" << cl->is_ternary_resolvent
-        << endl;
+    red_cl_keys.clear();
+    for(const ClOffset offset: solver->longRedCls[2]) {
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        if (cl->used_in_xor()
+            || cl->stats.ttl > 0
+            || cl->stats.marked_clause
+            || cl->stats.which_red_array != 2
+            || solver->clause_locked(*cl, offset)
+        ) {
+            //no need to mark, skip
+            continue;
+        }
+        red_cl_keys.push_back(RedClKey(offset, cl->stats.glue, cl->stats.activity));
     }
-    #endif
+}
+
+//Moves the best keep_num keys of [from, end) to the front, returns their end
+size_t ReduceDB::select_top_N_keys(
+    const size_t from
+    , const uint64_t keep_num
+    , const ClauseClean clean_type
+) {
+    if (red_cl_keys.size() - from <= keep_num) {
+        return red_cl_keys.size();
+    }
+    const auto begin = red_cl_keys.begin() + from;
+    const auto nth = begin + keep_num;
 
     switch (clean_type) {
         case ClauseClean::glue : {
-            std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(), SortRedClsGlue(solver->cl_alloc));
+            std::nth_element(begin, nth, red_cl_keys.end(),
+                [](const RedClKey& x, const RedClKey& y) {
+                    return x.glue < y.glue;
+            });
             break;
         }
 
         case ClauseClean::activity : {
-            std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(), SortRedClsAct(solver->cl_alloc));
+            std::nth_element(begin, nth, red_cl_keys.end(),
+                [](const RedClKey& x, const RedClKey& y) {
+                    return x.activity > y.activity;
+            });
             break;
         }
 
@@ -170,6 +178,7 @@ void ReduceDB::sort_red_cls(ClauseClean clean_type)
             assert(false && "Unknown cleaning type");
         }
     }
+    return from + keep_num;
 }
 
 //TODO maybe we chould count binary learnt clauses as well into the
@@ -184,6 +193,8 @@ void ReduceDB::handle_lev2()
 
     //lev2 -- clean
     int64_t num_to_reduce = solver->longRedCls[2].size();
+    fill_red_cl_keys();
+    size_t num_kept = 0;
     for(unsigned keep_type = 0
         ; keep_type < sizeof(solver->conf.ratio_keep_clauses)/sizeof(double)
         ; keep_type++
@@ -192,8 +203,11 @@ void ReduceDB::handle_lev2()
         if (keep_num == 0) {
             continue;
         }
-        sort_red_cls(static_cast<ClauseClean>(keep_type));
-        mark_top_N_clauses(keep_num);
+        num_kept = select_top_N_keys(num_kept, keep_num, static_cast<ClauseClean>(keep_type));
+    }
+    for(size_t i = 0; i < num_kept; i++) {
+        Clause* cl = solver->cl_alloc.ptr(red_cl_keys[i].offset);
+        cl->stats.marked_clause = true;
     }
     assert(delayed_clause_free.empty());
     cl_marked = 0;
@@ -396,6 +410,8 @@ void ReduceDB::handle_lev2_predictor()
     std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(),
               SortRedClsAct(solver->cl_alloc));
 
+    predictors->clear_rows();
+    to_predict.clear();
     for(size_t i = 0
         ; i < solver->longRedCls[2].size()
         ; i++
@@ -423,7 +439,7 @@ void ReduceDB::handle_lev2_predictor()
                 (int64_t)solver->sumConflicts-10000-(int64_t)cl->stats.rdb1_last_touched;
             #endif
 
-            predictors->predict(
+            predictors->add_row(
                 cl,
                 solver->sumConflicts,
                 last_touched_diff,
@@ -431,11 +447,9 @@ void ReduceDB::handle_lev2_predictor()
                 rdb1_last_touched_diff,
                 #endif
                 act_ranking_rel,
-                act_ranking_top_10,
-                cl->stats.pred_short_use,
-                cl->stats.pred_long_use,
-                cl->stats.pred_forever_use
+                act_ranking_top_10
             );
+            to_predict.push_back(offset);
         }
         cl->stats.dump_no++;
         #ifdef EXTENDED_FEATURES
@@ -446,6 +460,20 @@ void ReduceDB::handle_lev2_predictor()
         cl->stats.reset_rdb_stats();
     }
 
+    //The features were taken above, before the stats were reset
+    predictors->predict_rows(predict_type::short_pred, preds);
+    for(size_t i = 0; i < to_predict.size(); i++) {
+        solver->cl_alloc.ptr(to_predict[i])->stats.pred_short_use = preds[i];
+    }
+    predictors->predict_rows(predict_type::long_pred, preds);
+    for(size_t i = 0; i < to_predict.size(); i++) {
+        solver->cl_alloc.ptr(to_predict[i])->stats.pred_long_use = preds[i];
+    }
+    predictors->predict_rows(predict_type::forever_pred, preds);
+    for(size_t i = 0; i < to_predict.size(); i++) {
+        solver->cl_alloc.ptr(to_predict[i])->stats.pred_forever_use = preds[i];
+    }
+
     if (solver->conf.verbosity >= 1) {
         double predTime = cpuTime() - myTime;
         cout << "c [DBCL] main predtime: " << predTime << endl;
@@ -538,6 +566,7 @@ void ReduceDB::handle_lev2_predictor()
         std::sort(solver->longRedCls[0].begin(), solver->longRedCls[0].end(),
               SortRedClsAct(solver->cl_alloc));
 
+        predictors->clear_rows();
         for(size_t i = 0
             ; i < solver->longRedCls[0].size()
             ; i++
@@ -556,8 +585,7 @@ void ReduceDB::handle_lev2_predictor()
                 (int64_t)solver->sumConflicts-10000-(int64_t)cl->stats.rdb1_last_touched;
             #endif
 
-            cl->stats.pred_forever_use = predictors->predict(
-                predict_type::forever_pred,
+            predictors->add_row(
                 cl,
                 solver->sumConflicts,
                 last_touched_diff,
@@ -567,6 +595,11 @@ void ReduceDB::handle_lev2_predictor()
                 act_ranking_rel,
                 act_ranking_top_10);
         }
+        predictors->predict_rows(predict_type::forever_pred, preds);
+        for(size_t i = 0; i < solver->longRedCls[0].size(); i++) {
+            Clause* cl = solver->cl_alloc.ptr(solver->longRedCls[0][i]);
+            cl->stats.pred_forever_use = preds[i];
+        }
 
         //Clean up FOREVER, move to LONG
         keep_forever = orig_keep_forever;
@@ -594,6 +627,7 @@ void ReduceDB::handle_lev2_predictor()
         std::sort(solver->longRedCls[1].begin(), solver->longRedCls[1].end(),
               SortRedClsAct(solver->cl_alloc));
 
+        predictors->clear_rows();
         for(size_t i = 0
             ; i < solver->longRedCls[1].size()
             ; i++
@@ -612,8 +646,7 @@ void ReduceDB::handle_lev2_predictor()
                 (int64_t)solver->sumConflicts-10000-(int64_t)cl->stats.rdb1_last_touched;
             #endif
 
-            cl->stats.pred_long_use = predictors->predict(
-                predict_type::long_pred,
+            predictors->add_row(
                 cl,
                 solver->sumConflicts,
                 last_touched_diff,
@@ -623,6 +656,11 @@ void ReduceDB::handle_lev2_predictor()
                 act_ranking_rel,
                 act_ranking_top_10);
         }
+        predictors->predict_rows(predict_type::long_pred, preds);
+        for(size_t i = 0; i < solver->longRedCls[1].size(); i++) {
+            Clause* cl = solver->cl_alloc.ptr(solver->longRedCls[1][i]);
+            cl->stats.pred_long_use = preds[i];
+        }
 
         //Clean up LONG, move to SHORT
         std::sort(solver->longRedCls[1].begin(), solver->longRedCls[1].end(),
@@ -687,49 +725,6 @@ void ReduceDB::handle_lev2_predictor()
 }
 #endif
 
-void ReduceDB::mark_top_N_clauses(const uint64_t keep_num)
-{
-    #ifdef VERBOSE_DEBUG
-    cout << "Marking top N clauses " << keep_num << endl;
-    #endif
-
-    size_t marked = 0;
-    for(size_t i = 0
-        ; i < solver->longRedCls[2].size() && marked < keep_num
-        ; i++
-    ) {
-        const ClOffset offset = solver->longRedCls[2][i];
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        #ifdef VERBOSE_DEBUG
-        cout << "offset: " << offset << " cl->stats.last_touched: " << cl->stats.last_touched
-        << " act:" << std::setprecision(9) << cl->stats.activity
-        << " which_red_array:" << cl->stats.which_red_array << endl
-        << " -- cl:" << *cl << " tern:" << cl->is_ternary_resolvent
-        << endl;
-        #endif
-
-        if (cl->used_in_xor()
-            || cl->stats.ttl > 0
-            || solver->clause_locked(*cl, offset)
-            || cl->stats.which_red_array != 2
-        ) {
-            //no need to mark, skip
-            #ifdef VERBOSE_DEBUG
-            cout << "Not marking Skipping "<< endl;
-            #endif
-            continue;
-        }
-
-        if (!cl->stats.marked_clause) {
-            marked++;
-            cl->stats.marked_clause = true;
-            #ifdef VERBOSE_DEBUG
-            cout << "Not marking Skipping "<< endl;
-            #endif
-        }
-    }
-}
-
 bool ReduceDB::cl_needs_removal(const Clause* cl, const ClOffset offset) const
 {
     assert(cl->red());
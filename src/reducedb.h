@@ -62,11 +62,28 @@ private:
     bool cl_needs_removal(const Clause* cl, const ClOffset offset) const;
     void remove_cl_from_lev2();
 
-    void sort_red_cls(ClauseClean clean_type);
-    void mark_top_N_clauses(const uint64_t keep_num);
+    struct RedClKey {
+        RedClKey(const ClOffset _offset, const uint32_t _glue, const float _activity) :
+            offset(_offset)
+            , glue(_glue)
+            , activity(_activity)
+        {}
+        ClOffset offset;
+        uint32_t glue;
+        float activity;
+    };
+    vector<RedClKey> red_cl_keys;
+    void fill_red_cl_keys();
+    size_t select_top_N_keys(
+        const size_t from
+        , const uint64_t keep_num
+        , const ClauseClean clean_type
+    );
 
     #ifdef FINAL_PREDICTOR
     ClPredictors* predictors = NULL;
+    vector<ClOffset> to_predict;
+    vector<float> preds;
     uint32_t num_times_lev3_called = 0;
     #endif
 };
@@ -0,0 +1,172 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Measures the Gauss-Jordan row kernels of every kernel set this CPU supports,
+//over a range of matrix widths, and checks that they agree:
+//
+//   make cms_rowbench && ./cms_rowbench [millions of words per test]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "packedrow.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace CMSat;
+
+static double wall_time()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//A matrix with 'num_rows' rows of 'num_words' words, each bit set with
+//probability 1/'one_in'
+static vector<int64_t> random_rows(
+    std::mt19937_64& rnd,
+    const int num_rows,
+    const int num_words,
+    const unsigned one_in)
+{
+    vector<int64_t> ret((size_t)num_rows*num_words, 0);
+    for(int64_t& w: ret) {
+        for(int b = 0; b < 64; b++) {
+            if (rnd() % one_in == 0) {
+                w |= 1LL << b;
+            }
+        }
+    }
+    return ret;
+}
+
+struct Result
+{
+    double t[3];
+    uint64_t check[3];
+};
+
+static Result run(
+    const PackedRowKernels& k,
+    const int num_words,
+    const int num_rows,
+    const uint64_t reps,
+    const vector<int64_t>& dense,
+    const vector<int64_t>& sparse)
+{
+    Result res;
+
+    //Eliminate: xor rows into each other
+    vector<int64_t> mat = dense;
+    double t = wall_time();
+    for(uint64_t r = 0; r < reps; r++) {
+        const int i = r % num_rows;
+        const int j = (r*7 + 1) % num_rows;
+        if (i != j) {
+            k.xor_in(mat.data() + (size_t)i*num_words, mat.data() + (size_t)j*num_words, num_words);
+        }
+    }
+    res.t[0] = wall_time() - t;
+    res.check[0] = 0;
+    for(const int64_t w: mat) {
+        res.check[0] = res.check[0]*31 + (uint64_t)w;
+    }
+
+    //Propagate: rows against mostly-assigned columns
+    vector<int64_t> tmp(num_words);
+    res.check[1] = 0;
+    t = wall_time();
+    for(uint64_t r = 0; r < reps; r++) {
+        const int i = r % num_rows;
+        const int j = (r*3 + 1) % num_rows;
+        const uint32_t pop = k.set_and_until_popcnt_atleast2(
+            tmp.data(), dense.data() + (size_t)i*num_words,
+            sparse.data() + (size_t)j*num_words, num_words);
+        res.check[1] += std::min<uint32_t>(pop, 2);
+    }
+    res.t[1] = wall_time() - t;
+
+    //Scan for set bits of sparse rows
+    res.check[2] = 0;
+    t = wall_time();
+    for(uint64_t r = 0; r < reps; r++) {
+        const int64_t* row = sparse.data() + (size_t)(r % num_rows)*num_words;
+        for(int i = k.find_nonzero(row, 0, num_words)
+            ; i < num_words
+            ; i = k.find_nonzero(row, i+1, num_words)
+        ) {
+            res.check[2] += i;
+        }
+    }
+    res.t[2] = wall_time() - t;
+
+    return res;
+}
+
+int main(int argc, char** argv)
+{
+    double mwords = 50;
+    if (argc > 1) {
+        mwords = atof(argv[1]);
+    }
+
+    const vector<PackedRowKernels> kernels = available_row_kernels();
+    cout << "In use: " << row_kernels.name << endl;
+    cout << "Time in ns per row for [xor_in, set_and_until_popcnt_atleast2, find_nonzero]" << endl;
+
+    std::mt19937_64 rnd(42);
+    int ret = 0;
+    const int num_rows = 256;
+    for(const int num_cols: {128, 256, 512, 1024, 2048, 4096, 16384}) {
+        const int num_words = num_cols/64;
+        const vector<int64_t> dense = random_rows(rnd, num_rows, num_words, 2);
+        const vector<int64_t> sparse = random_rows(rnd, num_rows, num_words, 3*num_cols/4);
+        const uint64_t reps = std::max<uint64_t>(1000, mwords*1e6/num_words);
+
+        cout << "cols: " << std::setw(6) << num_cols << endl;
+        vector<Result> results;
+        for(const PackedRowKernels& k: kernels) {
+            results.push_back(run(k, num_words, num_rows, reps, dense, sparse));
+            const Result& r = results.back();
+            cout << "  " << std::left << std::setw(8) << k.name << std::right;
+            for(int i = 0; i < 3; i++) {
+                cout << std::fixed << std::setprecision(2)
+                << std::setw(10) << r.t[i]*1e9/reps;
+            }
+            for(int i = 0; i < 3; i++) {
+                if (r.check[i] != results[0].check[i]) {
+                    cout << "  ERROR: disagrees with " << kernels[0].name;
+                    ret = -1;
+                    break;
+                }
+            }
+            cout << endl;
+        }
+    }
+
+    return ret;
+}
@@ -86,6 +86,10 @@ void SatZillaFeaturesCalc::for_one_clause(
             break;
         }
 
+        case CMSat::watch_shared_t:
+            //not counted, the SharedClauseDB is not ours
+            break;
+
         case CMSat::watch_idx_t: {
              // This should never be here
             assert(false);
@@ -166,18 +166,18 @@ inline void Searcher::add_lit_to_learnt(
     #endif
 
     //If var is at level 0, don't do anything with it, just skip
-    if (seen[var] || varData[var].level == 0) {
+    if (seen[var] || varLevel[var] == 0) {
         return;
     }
     seen[var] = 1;
 
     if (!update_bogoprops) {
         #ifdef STATS_NEEDED_BRANCH
-        if (varData[var].level != 0 &&
-            !level_used_for_cl_arr[varData[var].level]
+        if (varLevel[var] != 0 &&
+            !level_used_for_cl_arr[varLevel[var]]
         ) {
-            level_used_for_cl_arr[varData[var].level] = 1;
-            level_used_for_cl.push_back(varData[var].level);
+            level_used_for_cl_arr[varLevel[var]] = 1;
+            level_used_for_cl.push_back(varLevel[var]);
         }
         #endif
 
@@ -199,7 +199,7 @@ inline void Searcher::add_lit_to_learnt(
         }
     }
 
-    if (varData[var].level >= nDecisionLevel) {
+    if (varLevel[var] >= nDecisionLevel) {
         pathC++;
     } else {
         learnt_clause.push_back(lit);
@@ -216,7 +216,7 @@ inline void Searcher::recursiveConfClauseMin()
 
     size_t i, j;
     for (i = j = 1; i < learnt_clause.size(); i++) {
-        if (varData[learnt_clause[i].var()].reason.isNULL()
+        if (varReason[learnt_clause[i].var()].isNULL()
             || !litRedundant(learnt_clause[i], abstract_level)
         ) {
             learnt_clause[j++] = learnt_clause[i];
@@ -229,9 +229,9 @@ void Searcher::normalClMinim()
 {
     size_t i,j;
     for (i = j = 1; i < learnt_clause.size(); i++) {
-        const PropBy& reason = varData[learnt_clause[i].var()].reason;
+        const PropBy& reason = varReason[learnt_clause[i].var()];
         size_t size;
-        Lit *lits = NULL;
+        const Lit *lits = NULL;
         PropByType type = reason.getType();
         if (type == null_clause_t) {
             learnt_clause[j++] = learnt_clause[i];
@@ -250,6 +250,13 @@ void Searcher::normalClMinim()
                 break;
             }
 
+            case shared_t: {
+                const vector<Lit>& cl2 = get_shared_cl(reason, learnt_clause[i].var());
+                lits = cl2.data();
+                size = cl2.size()-1;
+                break;
+            }
+
             #ifdef USE_GAUSS
             case xor_t: {
                 vector<Lit>* xor_reason = gmatrices[reason.get_matrix_num()]->
@@ -272,6 +279,7 @@ void Searcher::normalClMinim()
                 #ifdef USE_GAUSS
                 case xor_t:
                 #endif
+                case shared_t:
                 case clause_t:
                     p = lits[k+1];
                     break;
@@ -285,7 +293,7 @@ void Searcher::normalClMinim()
                     std::exit(-1);
             }
 
-            if (!seen[p.var()] && varData[p.var()].level > 0) {
+            if (!seen[p.var()] && varLevel[p.var()] > 0) {
                 learnt_clause[j++] = learnt_clause[i];
                 break;
             }
@@ -312,6 +320,11 @@ void Searcher::debug_print_resolving_clause(const PropBy confl) const
             break;
         }
 
+        case shared_t: {
+            cout << "resolv (shared): " << confl.get_shared_idx() << endl;
+            break;
+        }
+
         case xor_t: {
             //in the future, we'll have XOR clauses. Not yet.
             assert(false);
@@ -368,7 +381,7 @@ void Searcher::add_literals_from_confl_to_learnt(
     #endif
     sumAntecedents++;
 
-    Lit* lits = NULL;
+    const Lit* lits = NULL;
     size_t size = 0;
     switch (confl.getType()) {
         case binary_t : {
@@ -395,6 +408,7 @@ void Searcher::add_literals_from_confl_to_learnt(
             sumAntecedentsLits += cl->size();
             if (cl->red()) {
                 stats.resolvs.longRed++;
+                imported_cls_used += cl->stats.is_imported;
                 #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
                 antec_data.longRed++;
                 antec_data.age_long_reds.push(sumConflicts - cl->stats.introduced_at_conflict);
@@ -449,6 +463,20 @@ void Searcher::add_literals_from_confl_to_learnt(
             break;
         }
 
+        case shared_t : {
+            const vector<Lit>& cl = get_shared_cl(
+                confl, p == lit_Undef ? var_Undef : p.var());
+            lits = cl.data();
+            size = cl.size();
+            sumAntecedentsLits += size;
+            stats.resolvs.longIrred++;
+            #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
+            antec_data.longIrred++;
+            antec_data.size_longs.push(size);
+            #endif
+            break;
+        }
+
         #ifdef USE_GAUSS
         case xor_t: {
             vector<Lit>* xor_reason = gmatrices[confl.get_matrix_num()]->
@@ -480,6 +508,7 @@ void Searcher::add_literals_from_confl_to_learnt(
                 break;
 
             case clause_t:
+            case shared_t:
             #ifdef USE_GAUSS
             case xor_t:
             #endif
@@ -571,7 +600,7 @@ void Searcher::print_fully_minimized_learnt_clause() const
     if (conf.verbosity >= 6) {
         cout << "Final clause: " << learnt_clause << endl;
         for (uint32_t i = 0; i < learnt_clause.size(); i++) {
-            cout << "lev learnt_clause[" << i << "]:" << varData[learnt_clause[i].var()].level << endl;
+            cout << "lev learnt_clause[" << i << "]:" << varLevel[learnt_clause[i].var()] << endl;
         }
     }
 }
@@ -583,11 +612,11 @@ size_t Searcher::find_backtrack_level_of_learnt()
     else {
         uint32_t max_i = 1;
         for (uint32_t i = 2; i < learnt_clause.size(); i++) {
-            if (varData[learnt_clause[i].var()].level > varData[learnt_clause[max_i].var()].level)
+            if (varLevel[learnt_clause[i].var()] > varLevel[learnt_clause[max_i].var()])
                 max_i = i;
         }
         std::swap(learnt_clause[max_i], learnt_clause[1]);
-        return varData[learnt_clause[1].var()].level;
+        return varLevel[learnt_clause[1].var()];
     }
 }
 
@@ -618,10 +647,15 @@ void Searcher::create_learnt_clause(PropBy confl)
             break;
         }
 
+        case shared_t : {
+            lit0 = get_shared_cl(confl, var_Undef)[0];
+            break;
+        }
+
         default:
             assert(false);
     }
-    uint32_t nDecisionLevel = varData[lit0.var()].level;
+    uint32_t nDecisionLevel = varLevel[lit0.var()];
 
 
     learnt_clause.push_back(lit_Undef); //make space for ~p
@@ -640,8 +674,8 @@ void Searcher::create_learnt_clause(PropBy confl)
             assert(p != lit_Undef);
         } while(trail[index+1].lev < nDecisionLevel);
 
-        confl = varData[p.var()].reason;
-        assert(varData[p.var()].level > 0);
+        confl = varReason[p.var()];
+        assert(varLevel[p.var()] > 0);
 
         //This clears out vars that haven't been added to learnt_clause,
         //but their 'seen' has been set
@@ -680,6 +714,25 @@ void Searcher::simple_create_learnt_clause(
                     seen[q.var()] = 1;
                     mypathC++;
                 }
+            } else if (confl.getType() == shared_t) {
+                uint32_t first_var = var_Undef;
+                if (p != lit_Undef) {
+                    first_var = p.var();
+                } else if (True_confl) {
+                    first_var = out_learnt[0].var();
+                }
+                const vector<Lit>& c = get_shared_cl(confl, first_var);
+
+                for (uint32_t j = (p == lit_Undef && True_confl == false) ? 0 : 1
+                    ; j < c.size()
+                    ; j++
+                ) {
+                    Lit q = c[j];
+                    if (!seen[q.var()]) {
+                        seen[q.var()] = 1;
+                        mypathC++;
+                    }
+                }
             } else {
                 const Clause& c = *solver->cl_alloc.ptr(confl.get_offset());
 
@@ -715,11 +768,11 @@ void Searcher::simple_create_learnt_clause(
             until = out_learnt.size();
         }
         p = trail[index + 1].lit;
-        confl = varData[p.var()].reason;
+        confl = varReason[p.var()];
 
         //under normal circumstances this does not happen, but here, it can
         //reason is undefined for level 0
-        if (varData[p.var()].level == 0) {
+        if (varLevel[p.var()] == 0) {
             confl = PropBy();
         }
         seen[p.var()] = 0;
@@ -830,7 +883,7 @@ void Searcher::analyze_conflict(
     vars_used_for_cl.clear();
     for(auto& lev: level_used_for_cl) {
         vars_used_for_cl.push_back(trail[trail_lim[lev-1]].lit.var());
-        assert(varData[trail[trail_lim[lev-1]].lit.var()].reason == PropBy());
+        assert(varReason[trail[trail_lim[lev-1]].lit.var()] == PropBy());
         assert(level_used_for_cl_arr[lev] == 1);
         level_used_for_cl_arr[lev] = 0;
     }
@@ -842,7 +895,7 @@ void Searcher::analyze_conflict(
         switch(branch_strategy) {
             case branch::vsids:
                 for (const uint32_t var :implied_by_learnts) {
-                    if ((int32_t)varData[var].level >= (int32_t)out_btlevel-1) {
+                    if ((int32_t)varLevel[var] >= (int32_t)out_btlevel-1) {
                         vsids_bump_var_act<update_bogoprops>(var, 1.0);
                     }
                 }
@@ -856,8 +909,8 @@ void Searcher::analyze_conflict(
                 toClear.push_back(p);
                 for (int i = learnt_clause.size() - 1; i >= 0; i--) {
                     const uint32_t v = learnt_clause[i].var();
-                    if (varData[v].reason.isClause()) {
-                        ClOffset offs = varData[v].reason.get_offset();
+                    if (varReason[v].isClause()) {
+                        ClOffset offs = varReason[v].get_offset();
                         Clause* cl = cl_alloc.ptr(offs);
                         for (const Lit l: *cl) {
                             if (!seen[l.var()]) {
@@ -866,8 +919,16 @@ void Searcher::analyze_conflict(
                                 varData[l.var()].maple_conflicted+=bump_by;
                             }
                         }
-                    } else if (varData[v].reason.getType() == binary_t) {
-                        Lit l = varData[v].reason.lit2();
+                    } else if (varReason[v].getType() == shared_t) {
+                        for (const Lit l: get_shared_cl(varReason[v], v)) {
+                            if (!seen[l.var()]) {
+                                seen[l.var()] = true;
+                                toClear.push_back(l);
+                                varData[l.var()].maple_conflicted+=bump_by;
+                            }
+                        }
+                    } else if (varReason[v].getType() == binary_t) {
+                        Lit l = varReason[v].lit2();
                         if (!seen[l.var()]) {
                             seen[l.var()] = true;
                             toClear.push_back(l);
@@ -921,7 +982,8 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
         cout << "At point in litRedundant: " << analyze_stack.top() << endl;
         #endif
 
-        const PropBy reason = varData[analyze_stack.top().var()].reason;
+        const uint32_t reason_var = analyze_stack.top().var();
+        const PropBy reason = varReason[reason_var];
         PropByType type = reason.getType();
         analyze_stack.pop();
 
@@ -929,7 +991,7 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
         assert(!reason.isNULL());
 
         size_t size;
-        Lit* lits = NULL;
+        const Lit* lits = NULL;
         switch (type) {
             case clause_t: {
                 Clause* cl = cl_alloc.ptr(reason.get_offset());
@@ -938,6 +1000,13 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
                 break;
             }
 
+            case shared_t: {
+                const vector<Lit>& cl = get_shared_cl(reason, reason_var);
+                lits = cl.data();
+                size = cl.size()-1;
+                break;
+            }
+
             #ifdef USE_GAUSS
             case xor_t: {
                 vector<Lit>* xcl = gmatrices[reason.get_matrix_num()]->
@@ -966,6 +1035,7 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
                 #ifdef USE_GAUSS
                 case xor_t:
                 #endif
+                case shared_t:
                 case clause_t:
                     p2 = lits[i+1];
                     break;
@@ -980,8 +1050,8 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
             }
             stats.recMinimCost++;
 
-            if (!seen[p2.var()] && varData[p2.var()].level > 0) {
-                if (!varData[p2.var()].reason.isNULL()
+            if (!seen[p2.var()] && varLevel[p2.var()] > 0) {
+                if (!varReason[p2.var()].isNULL()
                     && (abstractLevel(p2.var()) & abstract_levels) != 0
                 ) {
                     seen[p2.var()] = 1;
@@ -1045,7 +1115,7 @@ void Searcher::analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& ou
 
     //It's been set at level 0. The seen[] may not be large enough to do
     //seen[p.var()] -- we might have mem-saved that
-    if (varData[p.var()].level == 0) {
+    if (varLevel[p.var()] == 0) {
         return;
     }
 
@@ -1055,9 +1125,9 @@ void Searcher::analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& ou
     for (int64_t i = (int64_t)trail.size() - 1; i >= (int64_t)trail_lim[0]; i--) {
         const uint32_t x = trail[i].lit.var();
         if (seen[x]) {
-            const PropBy reason = varData[x].reason;
+            const PropBy reason = varReason[x];
             if (reason.isNULL()) {
-                assert(varData[x].level > 0);
+                assert(varLevel[x] > 0);
                 out_conflict.push_back(~trail[i].lit);
             } else {
                 switch(reason.getType()) {
@@ -1065,7 +1135,7 @@ void Searcher::analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& ou
                         const Clause& cl = *cl_alloc.ptr(reason.get_offset());
                         assert(value(cl[0]) == l_True);
                         for(const Lit lit: cl) {
-                            if (varData[lit.var()].level > 0) {
+                            if (varLevel[lit.var()] > 0) {
                                 seen[lit.var()] = 1;
                             }
                         }
@@ -1074,19 +1144,28 @@ void Searcher::analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& ou
 
                     case PropByType::binary_t: {
                         const Lit lit = reason.lit2();
-                        if (varData[lit.var()].level > 0) {
+                        if (varLevel[lit.var()] > 0) {
                             seen[lit.var()] = 1;
                         }
                         break;
                     }
 
+                    case PropByType::shared_t: {
+                        for(const Lit lit: get_shared_cl(reason, x)) {
+                            if (varLevel[lit.var()] > 0) {
+                                seen[lit.var()] = 1;
+                            }
+                        }
+                        break;
+                    }
+
                     #ifdef USE_GAUSS
                     case PropByType::xor_t: {
                         vector<Lit>* cl = gmatrices[reason.get_matrix_num()]->
                             get_reason(reason.get_row_num());
                         assert(value((*cl)[0]) == l_True);
                         for(const Lit lit: *cl) {
-                            if (varData[lit.var()].level > 0) {
+                            if (varLevel[lit.var()] > 0) {
                                 seen[lit.var()] = 1;
                             }
                         }
@@ -1237,6 +1316,88 @@ void Searcher::check_need_gauss_jordan_disable()
 }
 #endif
 
+lbool Searcher::restart_to_level0()
+{
+    cancelUntil<true, false>(0);
+    PropBy confl = propagate<false>();
+    if (!confl.isNULL()) {
+        ok = false;
+        return l_False;
+    }
+    assert(solver->prop_at_head());
+    if (!solver->datasync->syncData()) {
+        return l_False;
+    }
+    return l_Undef;
+}
+
+/**
+@brief Number of decision levels that the next decisions would re-create anyway
+
+The decision variables of the kept levels are all more active than the best
+unassigned variable in the order heap, so they would be picked again, in the
+same order. Assumption levels are always kept. Only works for the heap-based
+branching strategies, returns 0 otherwise.
+*/
+uint32_t Searcher::trail_reuse_level()
+{
+    if (branch_strategy != branch::vsids && branch_strategy != branch::maple) {
+        return 0;
+    }
+
+    const uint32_t next = pick_var_vsids_maple();
+    if (next == var_Undef) {
+        return 0;
+    }
+    OrderHeap &order_heap = (branch_strategy == branch::vsids) ? order_heap_vsids : order_heap_maple;
+    const vector<ActAndOffset>& act = (branch_strategy == branch::vsids) ? var_act_vsids : var_act_maple;
+    order_heap.insert(next);
+    const double next_act = act[next].combine();
+
+    uint32_t lev = 0;
+    while (lev < decisionLevel()) {
+        if (lev >= assumptions.size()) {
+            const uint32_t v = trail[trail_lim[lev]].lit.var();
+            if (act[v].combine() <= next_act) {
+                break;
+            }
+        }
+        lev++;
+    }
+    return lev;
+}
+
+/**
+@brief Restarts only down to the level returned by trail_reuse_level()
+
+Returns false if a restart to level 0 is needed instead: either because
+syncing with other threads is due, nothing could be kept, or propagating the
+kept trail lead to a conflict.
+*/
+bool Searcher::restart_reusing_trail()
+{
+    if (!conf.restart_reuse_trail
+        || solver->datasync->sync_due()
+    ) {
+        return false;
+    }
+
+    const uint32_t lev = trail_reuse_level();
+    if (lev == 0) {
+        return false;
+    }
+
+    cancelUntil<true, false>(lev);
+    PropBy confl = propagate<false>();
+    if (!confl.isNULL()) {
+        return false;
+    }
+    assert(solver->prop_at_head());
+    stats.reuseTrailRestarts++;
+    stats.reuseTrailLevels += lev;
+    return true;
+}
+
 lbool Searcher::search()
 {
     assert(ok);
@@ -1323,19 +1484,11 @@ lbool Searcher::search()
     }
     max_confl_this_phase -= (int64_t)params.conflictsDoneThisRestart;
 
-    cancelUntil<true, false>(0);
-    confl = propagate<false>();
-    if (!confl.isNULL()) {
-        ok = false;
-        search_ret = l_False;
-        goto end;
-    }
-    assert(solver->prop_at_head());
-    if (!solver->datasync->syncData()) {
-        search_ret = l_False;
+    if (restart_reusing_trail()) {
+        search_ret = l_Undef;
         goto end;
     }
-    search_ret = l_Undef;
+    search_ret = restart_to_level0();
 
     end:
     dump_search_loop_stats(myTime);
@@ -1476,10 +1629,59 @@ void Searcher::update_history_stats(size_t backtrack_level, uint32_t glue)
     sumClSize += learnt_clause.size();
 }
 
+void Searcher::export_learnt_clause()
+{
+    //BVA variables don't exist for the user
+    if (get_num_bva_vars() > 0
+        && learn_cb_outer_to_without_bva.size() != nVarsOuter()
+    ) {
+        learn_cb_outer_to_without_bva = build_outer_to_without_bva_map();
+    }
+
+    learn_cb_lits.clear();
+    for(const Lit lit: learnt_clause) {
+        if (varData[lit.var()].is_bva) {
+            return;
+        }
+        const Lit outer = map_inter_to_outer(lit);
+        uint32_t v = outer.var();
+        if (get_num_bva_vars() > 0) {
+            v = learn_cb_outer_to_without_bva[v];
+        }
+        learn_cb_lits.push_back(outer.sign() ? -(int)(v+1) : (int)(v+1));
+    }
+    learn_cb_lits.push_back(0);
+
+    std::lock_guard<std::mutex> lock(ext_callbacks->learn_mutex);
+    ext_callbacks->learn(ext_callbacks->learn_state, learn_cb_lits.data());
+}
+
+bool Searcher::poll_terminate_callback()
+{
+    if (ext_callbacks == NULL
+        || ext_callbacks->terminate == NULL
+        || conf.thread_num != 0
+    ) {
+        return false;
+    }
+
+    if (ext_callbacks->terminate(ext_callbacks->terminate_state)) {
+        set_must_interrupt_asap();
+        return true;
+    }
+    return false;
+}
+
 template<bool update_bogoprops>
 void Searcher::attach_and_enqueue_learnt_clause(
     Clause* cl, const uint32_t level, const bool enq)
 {
+    if (ext_callbacks != NULL
+        && learnt_clause.size() <= ext_callbacks->learn_max_len
+    ) {
+        export_learnt_clause();
+    }
+
     switch (learnt_clause.size()) {
         case 0:
             assert(false);
@@ -1508,6 +1710,7 @@ void Searcher::attach_and_enqueue_learnt_clause(
         default:
             //Long learnt
             stats.learntLongs++;
+            solver->datasync->signalNewLongClause(learnt_clause, cl->stats.glue);
             solver->attachClause(*cl, enq);
             if (enq) enqueue(learnt_clause[0], level, PropBy(cl_alloc.get_offset(cl)));
             #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
@@ -1580,7 +1783,7 @@ void Searcher::dump_var_for_learnt_cl(const uint32_t v,
     //When it's a decision clause, the REAL clause could have already
     //set some variable to having been propagated (due to asserting clause)
     //so this assert() no longer holds for all literals
-    assert(is_decision || varData[v].reason == PropBy());
+    assert(is_decision || varReason[v] == PropBy());
     if (varData[v].dump) {
         uint64_t outer_var = map_inter_to_outer(v);
         solver->sqlStats->dec_var_clid(
@@ -1702,11 +1905,33 @@ Clause* Searcher::handle_last_confl(
         << fin;
         cl = NULL;
     } else {
+        unsigned which_arr = 2;
+        if (glue <= conf.glue_put_lev0_if_below_or_eq) {
+            which_arr = 0;
+        } else if (
+            glue <= conf.glue_put_lev1_if_below_or_eq
+            && conf.glue_put_lev1_if_below_or_eq != 0
+        ) {
+            which_arr = 1;
+        } else {
+            which_arr = 2;
+        }
+
+        //The tier selects the arena, so it must be final before allocation
+        #ifdef STATS_NEEDED
+        const bool locked_for_data_gen =
+            mtrand.randDblExc() < conf.lock_for_data_gen_ratio;
+        if (locked_for_data_gen) {
+            which_arr = 0;
+        }
+        #endif
+
         cl = cl_alloc.Clause_new(learnt_clause
         , sumConflicts
         #ifdef STATS_NEEDED
         , to_dump ? clauseID : 0
         #endif
+        , which_arr
         );
         cl->makeRed(sumConflicts);
         cl->stats.glue = glue;
@@ -1715,26 +1940,11 @@ Clause* Searcher::handle_last_confl(
         #endif
         cl->stats.activity = 0.0f;
         ClOffset offset = cl_alloc.get_offset(cl);
-        unsigned which_arr = 2;
 
         #ifdef STATS_NEEDED
-        cl->stats.locked_for_data_gen =
-            mtrand.randDblExc() < conf.lock_for_data_gen_ratio;
+        cl->stats.locked_for_data_gen = locked_for_data_gen;
         #endif
 
-        if (cl->stats.locked_for_data_gen) {
-            which_arr = 0;
-        } else if (glue <= conf.glue_put_lev0_if_below_or_eq) {
-            which_arr = 0;
-        } else if (
-            glue <= conf.glue_put_lev1_if_below_or_eq
-            && conf.glue_put_lev1_if_below_or_eq != 0
-        ) {
-            which_arr = 1;
-        } else {
-            which_arr = 2;
-        }
-
         if (which_arr == 0) {
             stats.red_cl_in_which0++;
         }
@@ -1837,7 +2047,7 @@ bool Searcher::handle_conflict(PropBy confl)
         }
         for(Lit l: decision_clause) {
             seen[l.toInt()] = 0;
-            assert(varData[l.var()].reason == PropBy());
+            assert(varReason[l.var()] == PropBy());
         }
     }
 
@@ -2162,7 +2372,7 @@ void Searcher::rebuildOrderHeap()
             //NOTE: the level==0 check is needed because SLS calls this
             //when there is a solution already, but we should only skip
             //level 0 assignments
-            || (value(v) != l_Undef && varData[v].level == 0)
+            || (value(v) != l_Undef && varLevel[v] == 0)
         ) {
             continue;
         } else {
@@ -2206,7 +2416,7 @@ void Searcher::rebuildOrderHeapVMTF()
             //NOTE: the level==0 check is needed because SLS calls this
             //when there is a solution already, but we should only skip
             //level 0 assignments
-            || (value(v) != l_Undef && varData[v].level == 0)
+            || (value(v) != l_Undef && varLevel[v] == 0)
         ) {
             //
         } else {
@@ -2557,6 +2767,9 @@ lbool Searcher::solve(
         }
 
         if (must_abort(status)) {
+            if (status == l_Undef && decisionLevel() > 0) {
+                status = restart_to_level0();
+            }
             goto end;
         }
 
@@ -2564,6 +2777,12 @@ lbool Searcher::solve(
             conf.do_distill_clauses &&
             sumConflicts > next_distill
         ) {
+            if (decisionLevel() > 0) {
+                status = restart_to_level0();
+                if (status != l_Undef) {
+                    goto end;
+                }
+            }
             if (!solver->distill_long_cls->distill(true, false)) {
                 status = l_False;
                 goto end;
@@ -2720,7 +2939,7 @@ void Searcher::check_need_restart()
             params.needToStopSearch = true;
         }
 
-        if (must_interrupt_asap())  {
+        if (must_interrupt_asap() || poll_terminate_callback())  {
             if (conf.verbosity >= 3)
                 cout << "c must_interrupt_asap() is set, restartig as soon as possible!" << endl;
             params.needToStopSearch = true;
@@ -2767,7 +2986,7 @@ void Searcher::print_solution_varreplace_status() const
         if (varData[var].removed == Removed::replaced
             || varData[var].removed == Removed::elimed
         ) {
-            assert(value(var) == l_Undef || varData[var].level == 0);
+            assert(value(var) == l_Undef || varLevel[var] == 0);
         }
 
         if (conf.verbosity >= 6
@@ -2777,7 +2996,7 @@ void Searcher::print_solution_varreplace_status() const
             cout
             << "var: " << var
             << " value: " << value(var)
-            << " level:" << varData[var].level
+            << " level:" << varLevel[var]
             << " type: " << removed_type_to_string(varData[var].removed)
             << endl;
         }
@@ -2934,7 +3153,7 @@ uint32_t Searcher::pick_var_vmtf()
 
 uint32_t Searcher::pick_var_vsids_maple()
 {
-    Heap<VarOrderLt> &order_heap = (branch_strategy == branch::vsids) ? order_heap_vsids : order_heap_maple;
+    OrderHeap &order_heap = (branch_strategy == branch::vsids) ? order_heap_vsids : order_heap_maple;
     uint32_t v = var_Undef;
     while (v == var_Undef || value(v) != l_Undef) {
         //There is no more to branch on. Satisfying assignment found.
@@ -3420,6 +3639,7 @@ void Searcher::read_long_cls(
         #ifdef STATS_NEEDED
         , cl_stats.ID
         #endif
+        , red ? cl_stats.which_red_array : ClauseAllocator::irred_arena
         );
         if (red) {
             cl->makeRed(sumConflicts);
@@ -3490,6 +3710,18 @@ void Searcher::save_state(SimpleOutFile& f, const lbool status) const
     f.put_vector(model);
     f.put_vector(conflict);
 
+    //Branching, restart and clause cleaning schedule
+    f.put_struct(var_inc_vsids);
+    f.put_struct(cla_inc);
+    f.put_uint64_t(luby_loop_num);
+    f.put_uint32_t(num_search_called);
+    f.put_uint32_t(branch_strategy_num);
+    f.put_struct(cur_rest_type);
+    f.put_uint64_t(next_lev1_reduce);
+    f.put_uint64_t(next_lev2_reduce);
+    f.put_uint64_t(next_lev3_reduce);
+    f.put_uint64_t(next_distill);
+
     //Clauses
     if (status == l_Undef) {
         write_binary_cls(f, false);
@@ -3508,6 +3740,7 @@ void Searcher::load_state(SimpleInFile& f, const lbool status)
 
     f.get_vector(var_act_vsids);
     f.get_vector(var_act_maple);
+    clear_order_heap();
     for(size_t i = 0; i < nVars(); i++) {
         if (varData[i].removed == Removed::none
             && value(i) == l_Undef
@@ -3518,6 +3751,17 @@ void Searcher::load_state(SimpleInFile& f, const lbool status)
     f.get_vector(model);
     f.get_vector(conflict);
 
+    f.get_struct(var_inc_vsids);
+    f.get_struct(cla_inc);
+    luby_loop_num = f.get_uint64_t();
+    num_search_called = f.get_uint32_t();
+    branch_strategy_num = f.get_uint32_t();
+    f.get_struct(cur_rest_type);
+    next_lev1_reduce = f.get_uint64_t();
+    next_lev2_reduce = f.get_uint64_t();
+    next_lev3_reduce = f.get_uint64_t();
+    next_distill = f.get_uint64_t();
+
     //Clauses
     if (status == l_Undef) {
         binTri.irredBins = read_binary_cls(f, false);
@@ -3615,7 +3859,7 @@ void Searcher::cancelUntil(uint32_t blevel)
             if (!update_bogoprops) {
                 varData[var].last_canceled = sumConflicts;
             }
-            if (!update_bogoprops && varData[var].reason == PropBy()) {
+            if (!update_bogoprops && varReason[var] == PropBy()) {
                 //we want to dump & this was a decision var
                 uint64_t sumConflicts_during = sumConflicts - varData[var].sumConflicts_at_picktime;
                 uint64_t sumDecisions_during = sumDecisions - varData[var].sumDecisions_at_picktime;
@@ -3763,17 +4007,17 @@ ConflictData Searcher::find_conflict_level(PropBy& pb)
     ConflictData data;
 
     if (pb.getType() == PropByType::binary_t) {
-        data.nHighestLevel = varData[failBinLit.var()].level;
+        data.nHighestLevel = varLevel[failBinLit.var()];
 
         if (data.nHighestLevel == decisionLevel()
-            && varData[pb.lit2().var()].level == decisionLevel()
+            && varLevel[pb.lit2().var()] == decisionLevel()
         ) {
             return data;
         }
 
         uint32_t highestId = 0;
         // find the largest decision level in the clause
-        uint32_t nLevel = varData[pb.lit2().var()].level;
+        uint32_t nLevel = varLevel[pb.lit2().var()];
         if (nLevel > data.nHighestLevel) {
             highestId = 1;
             data.nHighestLevel = nLevel;
@@ -3787,6 +4031,10 @@ ConflictData Searcher::find_conflict_level(PropBy& pb)
             failBinLit = back;
         }
 
+    } else if (pb.getType() == PropByType::shared_t) {
+        //Shared clauses can't be reordered, only their watches moved
+        data.nHighestLevel = varLevel[get_shared_cl(pb, var_Undef)[0].var()];
+        fix_shared_watches_for_confl(pb.get_shared_idx());
     } else {
         Lit* clause = NULL;
         uint32_t size = 0;
@@ -3811,14 +4059,15 @@ ConflictData Searcher::find_conflict_level(PropBy& pb)
             #endif
 
             case PropByType::binary_t:
+            case PropByType::shared_t:
             case PropByType::null_clause_t:
                 assert(false);
                 break;
         }
 
-        data.nHighestLevel = varData[clause[0].var()].level;
+        data.nHighestLevel = varLevel[clause[0].var()];
         if (data.nHighestLevel == decisionLevel()
-            && varData[clause[1].var()].level == decisionLevel()
+            && varLevel[clause[1].var()] == decisionLevel()
         ) {
             return data;
         }
@@ -3826,7 +4075,7 @@ ConflictData Searcher::find_conflict_level(PropBy& pb)
         uint32_t highestId = 0;
         // find the largest decision level in the clause
         for (uint32_t nLitId = 1; nLitId < size; ++nLitId) {
-            uint32_t nLevel = varData[clause[nLitId].var()].level;
+            uint32_t nLevel = varLevel[clause[nLitId].var()];
             if (nLevel > data.nHighestLevel) {
                 highestId = nLitId;
                 data.nHighestLevel = nLevel;
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "simplefile.h"
 #include "searchstats.h"
 #include "gqueuedata.h"
+#include "externalcallbacks.h"
 
 #ifdef CMS_TESTING_ENABLED
 #include "gtest/gtest_prod.h"
@@ -93,6 +94,7 @@ class Searcher : public HyperEngine
 
         ///////////////////////////////
         // Stats
+        uint64_t imported_cls_used = 0; ///<resolutions with clauses from other threads
         //Restart print status
         uint64_t lastRestartPrint = 0;
         uint64_t lastRestartPrintHeader = 0;
@@ -215,9 +217,24 @@ class Searcher : public HyperEngine
         void   setup_polarity_strategy();
         void   update_polarities_on_backtrack();
 
+        /////////////////
+        // Callbacks from the library API
+        void set_external_callbacks(ExternalCallbacks* callbacks)
+        {
+            ext_callbacks = callbacks;
+        }
+        bool poll_terminate_callback();
+
     protected:
         Solver* solver;
+        ExternalCallbacks* ext_callbacks = NULL;
+        void export_learnt_clause();
+        vector<int> learn_cb_lits;
+        vector<uint32_t> learn_cb_outer_to_without_bva;
         lbool search();
+        lbool restart_to_level0();
+        uint32_t trail_reuse_level();
+        bool restart_reusing_trail();
 
         ///////////////
         // Variables
@@ -438,7 +455,7 @@ class Searcher : public HyperEngine
 
 inline uint32_t Searcher::abstractLevel(const uint32_t x) const
 {
-    return ((uint32_t)1) << (varData[x].level & 31);
+    return ((uint32_t)1) << (varLevel[x] & 31);
 }
 
 inline const SearchStats& Searcher::get_stats() const
@@ -625,6 +642,7 @@ inline void Searcher::vsids_bump_var_act(uint32_t var, double mult, bool only_ad
 
         //Reset var_inc
         var_inc_vsids *= 1e-100;
+        order_heap_vsids.refresh_keys();
     }
 
     // Update order_heap with respect to new activity:
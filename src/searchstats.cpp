@@ -29,6 +29,8 @@ SearchStats& SearchStats::operator+=(const SearchStats& other)
     numRestarts += other.numRestarts;
     blocked_restart += other.blocked_restart;
     blocked_restart_same += other.blocked_restart_same;
+    reuseTrailRestarts += other.reuseTrailRestarts;
+    reuseTrailLevels += other.reuseTrailLevels;
 
     //Decisions
     decisions += other.decisions;
@@ -87,6 +89,8 @@ SearchStats& SearchStats::operator-=(const SearchStats& other)
     numRestarts -= other.numRestarts;
     blocked_restart -= other.blocked_restart;
     blocked_restart_same -= other.blocked_restart_same;
+    reuseTrailRestarts -= other.reuseTrailRestarts;
+    reuseTrailLevels -= other.reuseTrailLevels;
 
     //Decisions
     decisions -= other.decisions;
@@ -160,6 +164,16 @@ void SearchStats::printCommon(uint64_t props, bool do_print_times) const
         , "per normal restart"
 
     );
+    print_stats_line("c trail-reusing restarts"
+        , reuseTrailRestarts
+        , stats_line_percent(reuseTrailRestarts, numRestarts)
+        , "% of restarts"
+    );
+    print_stats_line("c levels reused"
+        , reuseTrailLevels
+        , float_div(reuseTrailLevels, reuseTrailRestarts)
+        , "per trail-reusing restart"
+    );
     if (do_print_times)
     print_stats_line("c time", cpu_time);
     print_stats_line("c decisions", decisions
@@ -50,6 +50,8 @@ public:
     uint64_t blocked_restart = 0;
     uint64_t blocked_restart_same = 0;
     uint64_t numRestarts = 0;
+    uint64_t reuseTrailRestarts = 0;
+    uint64_t reuseTrailLevels = 0;
 
     //Decisions
     uint64_t  decisions = 0;
@@ -0,0 +1,103 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef SHARED_CLAUSE_DB_H
+#define SHARED_CLAUSE_DB_H
+
+#include "cryptominisat5/solvertypesmini.h"
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+using std::vector;
+
+namespace CMSat {
+
+/**
+@brief The original long irredundant clauses, stored once for all threads
+
+Clauses are only ever added between solve() calls, while no thread runs, and
+are never changed or removed. During solving every thread reads it
+concurrently, without locking.
+
+A thread that uses it does not own these clauses: it only keeps, per clause,
+which two literals it watches (see PropEngine::shared_watched). When such
+a thread wants to simplify, it first makes private copies of all of them and
+stops using the shared ones (PropEngine::unshare_clauses()).
+*/
+class SharedClauseDB
+{
+    public:
+        SharedClauseDB() :
+            start(1, 0)
+        {}
+
+        ///Sorts, removes duplicates. Returns true if it's a long clause that goes here
+        static bool normalise(vector<Lit>& lits)
+        {
+            std::sort(lits.begin(), lits.end());
+            lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+            for(size_t i = 1; i < lits.size(); i++) {
+                if (lits[i-1] == ~lits[i]) {
+                    return false;
+                }
+            }
+            return lits.size() >= 3;
+        }
+
+        ///Clause must have been normalise()-d
+        void add(const vector<Lit>& lits)
+        {
+            assert(lits.size() >= 3);
+            data.insert(data.end(), lits.begin(), lits.end());
+            start.push_back(data.size());
+        }
+
+        uint32_t size() const
+        {
+            return start.size()-1;
+        }
+
+        const Lit* lits(const uint32_t idx) const
+        {
+            return data.data() + start[idx];
+        }
+
+        uint32_t cl_size(const uint32_t idx) const
+        {
+            return start[idx+1] - start[idx];
+        }
+
+        size_t mem_used() const
+        {
+            return data.capacity()*sizeof(Lit) + start.capacity()*sizeof(uint64_t);
+        }
+
+    private:
+        vector<Lit> data;
+        vector<uint64_t> start; ///<clause i is data[start[i]...start[i+1]]
+};
+
+}
+
+#endif //SHARED_CLAUSE_DB_H
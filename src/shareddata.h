@@ -24,9 +24,13 @@ THE SOFTWARE.
 #define SHARED_DATA_H
 
 #include "cryptominisat5/solvertypesmini.h"
+#include "portfolio.h"
 
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cassert>
 using std::vector;
 using std::mutex;
 
@@ -36,7 +40,9 @@ class SharedData
 {
     public:
         SharedData(const uint32_t _num_threads) :
-            num_threads(_num_threads)
+            long_cls(_num_threads)
+            , portfolio(_num_threads)
+            , num_threads(_num_threads)
         {}
 
         struct Spec {
@@ -67,11 +73,85 @@ class SharedData
                 data = NULL;
             }
         };
+        //Bounded ring of short learnt clauses exported by one thread.
+        //There is exactly one writer (the owning thread) and any number of
+        //readers. Every slot is protected by a sequence number: odd while
+        //being written, 2*(n+1) once the n-th clause has been fully written.
+        //A reader that is lapped by the writer simply loses those clauses.
+        class ClauseRing
+        {
+            public:
+                static const uint32_t max_size = 8;
+                static const uint64_t num_slots = 1ULL << 12;
+
+                uint64_t get_head() const
+                {
+                    return head.load(std::memory_order_acquire);
+                }
+
+                void push(const vector<Lit>& lits, const uint32_t glue)
+                {
+                    assert(lits.size() <= max_size);
+                    const uint64_t n = head.load(std::memory_order_relaxed);
+                    Slot& s = slots[n & (num_slots-1)];
+                    s.seq.store(2*n+1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    s.size.store(lits.size(), std::memory_order_relaxed);
+                    s.glue.store(glue, std::memory_order_relaxed);
+                    for(uint32_t i = 0; i < lits.size(); i++) {
+                        s.lits[i].store(lits[i].toInt(), std::memory_order_relaxed);
+                    }
+                    s.seq.store(2*n+2, std::memory_order_release);
+                    head.store(n+1, std::memory_order_release);
+                }
+
+                //Returns false if the slot has been overwritten meanwhile
+                bool get(const uint64_t n, vector<Lit>& lits, uint32_t& glue) const
+                {
+                    const Slot& s = slots[n & (num_slots-1)];
+                    const uint64_t seq = s.seq.load(std::memory_order_acquire);
+                    if (seq != 2*n+2) {
+                        return false;
+                    }
+                    const uint32_t sz = std::min<uint32_t>(
+                        s.size.load(std::memory_order_relaxed), max_size);
+                    glue = s.glue.load(std::memory_order_relaxed);
+                    lits.resize(sz);
+                    for(uint32_t i = 0; i < sz; i++) {
+                        lits[i] = Lit::toLit(s.lits[i].load(std::memory_order_relaxed));
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    return s.seq.load(std::memory_order_relaxed) == seq;
+                }
+
+            private:
+                struct Slot {
+                    std::atomic<uint64_t> seq{0};
+                    std::atomic<uint32_t> size{0};
+                    std::atomic<uint32_t> glue{0};
+                    std::atomic<uint32_t> lits[max_size];
+                };
+                std::atomic<uint64_t> head{0};
+                Slot slots[num_slots];
+        };
+
         vector<lbool> value;
         vector<Spec> bins;
+        vector<ClauseRing> long_cls;
         std::mutex unit_mutex;
         std::mutex bin_mutex;
 
+        //equiv[var] is a literal var is known to be equivalent to, or lit_Undef
+        vector<Lit> equiv;
+        std::mutex equiv_mutex;
+
+        //Phases of the longest trail any thread has reached so far
+        vector<lbool> best_phase;
+        uint32_t best_phase_trail = 0;
+        uint64_t best_phase_version = 0; ///<incremented at every update
+        std::mutex phase_mutex;
+        Portfolio portfolio;
+
         uint32_t num_threads;
 
         size_t calc_memory_use_bins()
@@ -44,6 +44,13 @@ public:
         //outf->rdbuf()->pubsetbuf(&buffer.front(), buffer.size());
     }
 
+    //Write into memory instead, e.g. to hand the data to another thread
+    void start(vector<char>* _buf)
+    {
+        buf = _buf;
+        buf->clear();
+    }
+
     ~SimpleOutFile()
     {
         delete outf;
@@ -87,10 +94,15 @@ public:
 
 private:
     std::ofstream* outf = NULL;
+    vector<char>* buf = NULL;
     //vector<char> buffer;
 
     void put(const void* ptr, size_t num)
     {
+        if (buf) {
+            buf->insert(buf->end(), (const char*)ptr, (const char*)ptr + num);
+            return;
+        }
         outf->write((const char*)ptr, num);
     }
 };
@@ -144,7 +156,7 @@ public:
     template<class T>
     void get_vector(vector<T>& d)
     {
-        assert(d.empty());
+        d.clear();
         uint64_t sz = get_uint64_t();
         if (sz == 0)
             return;
@@ -51,6 +51,7 @@ THE SOFTWARE.
 #include "distillerlongwithimpl.h"
 #include "str_impl_w_impl.h"
 #include "datasync.h"
+#include "shareddata.h"
 #include "reducedb.h"
 #include "clausedumper.h"
 #include "sccfinder.h"
@@ -68,6 +69,7 @@ THE SOFTWARE.
 #include "sls.h"
 #include "matrixfinder.h"
 #include "lucky.h"
+#include "checkpointer.h"
 
 #ifdef USE_BREAKID
 #include "cms_breakid.h"
@@ -152,6 +154,7 @@ Solver::~Solver()
     delete breakid;
 #endif
     delete card_finder;
+    delete checkpointer;
 }
 
 void Solver::enable_comphandler()
@@ -184,6 +187,193 @@ void Solver::set_sqlite(string
 void Solver::set_shared_data(SharedData* shared_data)
 {
     datasync->set_shared_data(shared_data);
+    portfolio = NULL;
+    if (shared_data && conf.portfolio_reconf_every > 0) {
+        portfolio = &shared_data->portfolio;
+    }
+}
+
+void Solver::set_portfolio_base_conf(const SolverConf& base)
+{
+    portfolio_base_conf = base;
+}
+
+//The settings that update_config() and reconfigure() change
+static void restore_search_tuning(SolverConf& conf, const SolverConf& base)
+{
+    conf.branch_strategy_setup = base.branch_strategy_setup;
+    conf.every_lev1_reduce = base.every_lev1_reduce;
+    conf.every_lev2_reduce = base.every_lev2_reduce;
+    conf.glue_put_lev0_if_below_or_eq = base.glue_put_lev0_if_below_or_eq;
+    conf.glue_put_lev1_if_below_or_eq = base.glue_put_lev1_if_below_or_eq;
+    conf.adjust_glue_if_too_many_low = base.adjust_glue_if_too_many_low;
+    for(size_t i = 0; i < sizeof(conf.ratio_keep_clauses)/sizeof(conf.ratio_keep_clauses[0]); i++) {
+        conf.ratio_keep_clauses[i] = base.ratio_keep_clauses[i];
+    }
+    conf.inc_max_temp_lev2_red_cls = base.inc_max_temp_lev2_red_cls;
+    conf.max_temp_lev2_learnt_clauses = base.max_temp_lev2_learnt_clauses;
+    conf.never_stop_search = base.never_stop_search;
+    conf.varElimRatioPerIter = base.varElimRatioPerIter;
+    conf.restartType = base.restartType;
+    conf.restart_inc = base.restart_inc;
+    conf.restart_first = base.restart_first;
+    conf.polarity_mode = base.polarity_mode;
+    conf.do_bva = base.do_bva;
+    conf.orig_global_timeout_multiplier = base.orig_global_timeout_multiplier;
+    conf.global_timeout_multiplier = base.global_timeout_multiplier;
+    conf.global_multiplier_multiplier_max = base.global_multiplier_multiplier_max;
+    conf.num_conflicts_of_search_inc = base.num_conflicts_of_search_inc;
+    conf.more_red_minim_limit_binary = base.more_red_minim_limit_binary;
+    conf.max_num_lits_more_more_red_min = base.max_num_lits_more_more_red_min;
+    conf.max_glue_more_minim = base.max_glue_more_minim;
+    conf.doMinimRedMoreMore = base.doMinimRedMoreMore;
+    conf.shortTermHistorySize = base.shortTermHistorySize;
+    conf.doAlwaysFMinim = base.doAlwaysFMinim;
+    conf.update_glues_on_analyze = base.update_glues_on_analyze;
+}
+
+//Scores the search iteration just finished, and switches configuration
+//if the Portfolio found this thread to be the weakest
+void Solver::report_to_portfolio(const double search_time)
+{
+    const SearchStats& st = Searcher::get_stats();
+    const uint64_t confl = st.conflStats.numConflicts;
+    const uint64_t recv = datasync->get_stats().recvLongData;
+
+    ThreadScore score;
+    score.confl_per_sec = float_div(confl, search_time);
+    score.good_learnt_ratio = float_div(st.red_cl_in_which0, confl);
+    score.trail_ratio = float_div(longest_trail_ever, nVars());
+    score.imported_use = float_div(
+        imported_cls_used - portfolio_last_used
+        , recv - portfolio_last_recv);
+    portfolio_last_used = imported_cls_used;
+    portfolio_last_recv = recv;
+
+    const int val = portfolio->report(
+        conf.thread_num, score, conf.portfolio_reconf_every);
+    if (val != 0) {
+        if (conf.verbosity) {
+            cout << "c [portfolio] thread " << conf.thread_num
+            << " reconfigured to " << val << endl;
+        }
+        //From the base configuration, so that switches don't stack on each
+        //other or on this thread's own tuning. Limits, and what was set up
+        //for sharing, are kept
+        restore_search_tuning(conf, portfolio_base_conf);
+        reset_temp_cl_num();
+        reconfigure(val);
+    }
+}
+
+void Solver::set_shared_cls_db(const SharedClauseDB* db)
+{
+    assert(nVarsOuter() == 0 && longIrredCls.empty());
+    shared_cls_db = db;
+}
+
+//The long clauses of the SharedClauseDB are not added, only watched.
+//See attach_shared_clauses()
+bool Solver::in_shared_cls_db(const vector<Lit>& lits)
+{
+    if (shared_cls_db == NULL) {
+        return false;
+    }
+    shared_cls_tmp = lits;
+    return SharedClauseDB::normalise(shared_cls_tmp);
+}
+
+//Shared clauses are watched with their literals as the user gave them, so
+//outside, outer and inter numbering must all be the same for them
+bool Solver::shared_cl_numbering_ok(const uint32_t idx) const
+{
+    const bool renumber = get_num_bva_vars() > 0 || !fresh_solver;
+    for(uint32_t k = 0; k < shared_cls_db->cl_size(idx); k++) {
+        const Lit lit = shared_cls_db->lits(idx)[k];
+        const Lit outer = renumber ? map_to_with_bva(lit) : lit;
+        if (outer != lit || map_outer_to_inter(outer) != lit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Watches the clauses added to the SharedClauseDB since the last call
+bool Solver::attach_shared_clauses()
+{
+    if (!ok) {
+        return false;
+    }
+    assert(decisionLevel() == 0);
+
+    for(uint32_t idx = shared_watched.size()/2; idx < shared_cls_db->size(); idx++) {
+        if (!shared_cl_numbering_ok(idx)) {
+            //Private, renumbered copies of everything instead
+            if (conf.verbosity) {
+                cout << "c [shared-cls] variables were renumbered, not sharing"
+                << endl;
+            }
+            return unshare_clauses();
+        }
+        if (!attach_shared_clause(idx)) {
+            ok = false;
+            return false;
+        }
+    }
+    ok = propagate<true>().isNULL();
+
+    return ok;
+}
+
+/**
+@brief Makes private copies of the shared clauses and stops watching them
+
+Simplification changes, renumbers and removes clauses, so it needs to own
+them. The SharedClauseDB itself is not touched.
+*/
+bool Solver::unshare_clauses()
+{
+    if (shared_cls_db == NULL) {
+        return okay();
+    }
+    assert(decisionLevel() == 0);
+    const double myTime = cpuTime();
+
+    for(watch_subarray ws: watches) {
+        Watched* i = ws.begin();
+        Watched* j = i;
+        for(Watched* end = ws.end(); i != end; i++) {
+            if (!i->isShared()) {
+                *j++ = *i;
+            }
+        }
+        ws.shrink_(i-j);
+    }
+    for(const Trail& t: trail) {
+        if (varReason[t.lit.var()].getType() == shared_t) {
+            varReason[t.lit.var()] = PropBy();
+        }
+    }
+
+    const SharedClauseDB* db = shared_cls_db;
+    shared_cls_db = NULL;
+    shared_watched.clear();
+    shared_watched.shrink_to_fit();
+    vector<Lit> lits;
+    for(uint32_t idx = 0; idx < db->size() && ok; idx++) {
+        lits.assign(db->lits(idx), db->lits(idx) + db->cl_size(idx));
+        back_number_from_outside_to_outer(lits);
+        addClauseInt(back_number_from_outside_to_outer_tmp);
+    }
+
+    if (conf.verbosity) {
+        cout << "c [shared-cls] made private copies of " << db->size()
+        << " clauses"
+        << conf.print_times(cpuTime() - myTime)
+        << endl;
+    }
+
+    return okay();
 }
 
 bool Solver::add_xor_clause_inter(
@@ -484,6 +674,7 @@ Clause* Solver::add_clause_int(
             #ifdef STATS_NEEDED
             , cl_stats.ID
             #endif
+            , red ? cl_stats.which_red_array : ClauseAllocator::irred_arena
             );
             if (red) {
                 c->makeRed(sumConflicts);
@@ -728,10 +919,27 @@ bool Solver::addClauseInt(vector<Lit>& ps, bool red)
         finalCl_tmp.clear();
         pFinalCl = &finalCl_tmp;
     }
+
+    //The tier selects the arena, so it must be known before allocation
+    ClauseStats cl_stats;
+    if (red) {
+        #ifndef FINAL_PREDICTOR
+        cl_stats.which_red_array = 2;
+        if (cl_stats.glue <= conf.glue_put_lev0_if_below_or_eq) {
+            cl_stats.which_red_array = 0;
+        } else if (cl_stats.glue <= conf.glue_put_lev1_if_below_or_eq
+            && conf.glue_put_lev1_if_below_or_eq != 0
+        ) {
+            cl_stats.which_red_array = 1;
+        }
+        #else
+        cl_stats.which_red_array = 3;
+        #endif
+    }
     Clause *cl = add_clause_int(
         ps
         , red
-        , ClauseStats() //default stats
+        , cl_stats
         , true //yes, attach
         , pFinalCl
         , false //add drat?
@@ -772,16 +980,6 @@ bool Solver::addClauseInt(vector<Lit>& ps, bool red)
         } else {
             #ifndef FINAL_PREDICTOR
             assert(!cl->stats.locked_for_data_gen);
-            cl->stats.which_red_array = 2;
-            if (cl->stats.glue <= conf.glue_put_lev0_if_below_or_eq) {
-                cl->stats.which_red_array = 0;
-            } else if (cl->stats.glue <= conf.glue_put_lev1_if_below_or_eq
-                && conf.glue_put_lev1_if_below_or_eq != 0
-            ) {
-                cl->stats.which_red_array = 1;
-            }
-            #else
-            cl->stats.which_red_array = 3;
             #endif
             longRedCls[cl->stats.which_red_array].push_back(offset);
         }
@@ -1617,6 +1815,12 @@ lbool Solver::solve_with_assumptions(
 
     //Clean up as a startup
     datasync->rebuild_bva_map();
+    datasync->start_net_sync();
+
+    if (conf.resume_from_checkpoint) {
+        conf.resume_from_checkpoint = false;
+        status = resume_from_checkpoint(conf.checkpoint_file);
+    }
 
     if (conf.preprocess == 2) {
         status = load_state(conf.saved_state_file);
@@ -1850,6 +2054,7 @@ lbool Solver::iterate_until_solved()
 
     while (status == l_Undef
         && !must_interrupt_asap()
+        && !poll_terminate_callback()
         && cpuTime() < conf.maxTime
         && sumConflicts < (uint64_t)conf.max_confl
     ) {
@@ -1870,7 +2075,11 @@ lbool Solver::iterate_until_solved()
         }
         all_matrices_disabled = false;
         #endif //USE_GAUSS
+        const double search_start = cpuTime();
         status = Searcher::solve(num_confl);
+        if (portfolio && status == l_Undef) {
+            report_to_portfolio(cpuTime() - search_start);
+        }
 
         //Check for effectiveness
         check_recursive_minimization_effectiveness(status);
@@ -1901,9 +2110,15 @@ lbool Solver::iterate_until_solved()
         }
         if (status == l_Undef) {
             check_reconfigure();
+            save_checkpoint();
         }
     }
 
+    //Interrupted, e.g. the job is being preempted, or stopped by a limit
+    if (status == l_Undef) {
+        save_checkpoint(true);
+    }
+
     end:
     return status;
 }
@@ -2193,7 +2408,7 @@ lbool Solver::simplify_problem(const bool startup)
     }
 
     lbool ret = l_Undef;
-    if (!okay()) {
+    if (!unshare_clauses()) {
         ret = l_False;
     }
 
@@ -2388,6 +2603,9 @@ void Solver::print_norm_stats(const double cpu_time, const double cpu_time_total
         , stats_line_percent(reduceDB->get_total_time(), cpu_time)
         , "% time"
     );
+    if (datasync->enabled()) {
+        datasync->get_stats().print();
+    }
 
     //OccSimplifier stats
     if (conf.perform_occur_based_simp) {
@@ -2581,6 +2799,8 @@ uint64_t Solver::mem_used_vardata() const
     uint64_t mem = 0;
     mem += assigns.capacity()*sizeof(lbool);
     mem += varData.capacity()*sizeof(VarData);
+    mem += varLevel.capacity()*sizeof(uint32_t);
+    mem += varReason.capacity()*sizeof(PropBy);
 
     return mem;
 }
@@ -3133,10 +3353,48 @@ bool Solver::add_clause_outer(const vector<Lit>& lits, bool red)
     #ifdef SLOW_DEBUG //we check for this during back-numbering
     check_too_large_variable_number(lits);
     #endif
+    if (!red) {
+        for(const Lit lit: lits) {
+            hash_input(lit.toInt());
+        }
+        hash_input(lit_Undef.toInt());
+    }
+    if (in_shared_cls_db(lits)) {
+        return true;
+    }
     back_number_from_outside_to_outer(lits);
     return addClauseInt(back_number_from_outside_to_outer_tmp, red);
 }
 
+//DIMACS-style: var+1 or -(var+1), each clause terminated by 0. Literals are
+//renumbered straight into the temporary that addClauseInt() works on
+bool Solver::add_clauses_outer(const int* lits, const size_t num_lits)
+{
+    const bool renumber = get_num_bva_vars() > 0 || !fresh_solver;
+    const int* const end = lits + num_lits;
+    vector<Lit>& cl = back_number_from_outside_to_outer_tmp;
+    while (lits != end && ok) {
+        cl.clear();
+        for(; lits != end && *lits != 0; lits++) {
+            //-(x+1) can't overflow, unlike std::abs(x) for INT_MIN
+            const Lit lit(*lits > 0 ? *lits-1 : -(*lits+1), *lits < 0);
+            assert(lit.var() < nVarsOutside());
+            hash_input(lit.toInt());
+            cl.push_back(renumber ? map_to_with_bva(lit) : lit);
+        }
+        hash_input(lit_Undef.toInt());
+        if (lits != end) {
+            lits++;
+        }
+        if (in_shared_cls_db(cl)) {
+            continue;
+        }
+        addClauseInt(cl);
+    }
+
+    return ok;
+}
+
 bool Solver::add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs)
 {
     if (!ok) {
@@ -3146,7 +3404,10 @@ bool Solver::add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs)
     vector<Lit> lits(vars.size());
     for(size_t i = 0; i < vars.size(); i++) {
         lits[i] = Lit(vars[i], false);
+        hash_input(vars[i]);
     }
+    hash_input(rhs);
+    hash_input(lit_Error.toInt());
     #ifdef SLOW_DEBUG //we check for this during back-numbering
     check_too_large_variable_number(lits);
     #endif
@@ -3502,9 +3763,14 @@ void Solver::save_state(const string& fname, const lbool status) const
 {
     SimpleOutFile f;
     f.start(fname);
+    save_state(f, status);
+}
 
+void Solver::save_state(SimpleOutFile& f, const lbool status) const
+{
     f.put_lbool(status);
     Searcher::save_state(f, status);
+    f.put_struct(solveStats);
     //f.put_struct(sumStats);
     //f.put_struct(sumPropStats);
     //f.put_vector(outside_assumptions);
@@ -3519,9 +3785,14 @@ lbool Solver::load_state(const string& fname)
 {
     SimpleInFile f;
     f.start(fname);
+    return load_state(f);
+}
 
+lbool Solver::load_state(SimpleInFile& f)
+{
     const lbool status = f.get_lbool();
     Searcher::load_state(f, status);
+    f.get_struct(solveStats);
     //f.get_struct(sumStats);
     //f.get_struct(sumPropStats);
     //f.get_vector(outside_assumptions);
@@ -3534,6 +3805,122 @@ lbool Solver::load_state(const string& fname)
     return status;
 }
 
+//Bump when the layout of save_state() changes
+static const uint64_t checkpoint_magic = 0x32544B43534D43ULL; //"CMSCKT2"
+
+void Solver::save_checkpoint(const bool force)
+{
+    //Wall time: a preempted job loses wall time, not CPU time
+    const auto now = std::chrono::steady_clock::now();
+    if (conf.checkpoint_file.empty()
+        || (!force
+            && std::chrono::duration<double>(now - last_checkpoint_time).count()
+                < conf.checkpoint_every)
+    ) {
+        return;
+    }
+    assert(decisionLevel() == 0);
+
+    //Not a state we can resume from
+    if (!okay() || !outside_assumptions.empty() || drat->enabled()
+        || shared_cls_db != NULL
+    ) {
+        return;
+    }
+    #ifdef USE_GAUSS
+    if (detached_xor_clauses && (!force || !fully_undo_xor_detach())) {
+        if (conf.verbosity) {
+            cout << "c [checkpoint] skipped, XOR clauses are detached" << endl;
+        }
+        return;
+    }
+    #endif
+
+    if (checkpointer == NULL) {
+        checkpointer = new Checkpointer(conf.checkpoint_file);
+    }
+    if (force) {
+        //The last one before exiting must not be skipped
+        checkpointer->wait();
+    } else if (checkpointer->busy()) {
+        //We are faster than the disk, skip this one
+        if (conf.verbosity) {
+            cout << "c [checkpoint] skipped, the previous one is still being written" << endl;
+        }
+        return;
+    }
+    if (!checkpointer->get_error().empty()) {
+        cout << "c WARNING: writing checkpoint failed: "
+        << checkpointer->get_error() << endl;
+    }
+
+    const double myTime = cpuTime();
+    SimpleOutFile f;
+    f.start(&checkpointer->buffer());
+    f.put_uint64_t(checkpoint_magic);
+    f.put_uint32_t(nVarsOuter());
+    f.put_uint32_t(occsimplifier != NULL);
+    save_state(f, l_Undef);
+    f.put_uint64_t(checkpoint_magic);
+    checkpointer->write_async();
+    last_checkpoint_time = now;
+
+    if (conf.verbosity) {
+        cout << "c [checkpoint] serialized "
+        << std::setprecision(2) << std::fixed
+        << (double)checkpointer->buffer().size()/(1024.0*1024.0) << " MB"
+        << " conflicts: " << sumConflicts
+        << conf.print_times(cpuTime() - myTime)
+        << endl;
+    }
+
+    //We are about to exit, make sure it's on disk
+    if (force && !checkpointer->wait()) {
+        cout << "c WARNING: writing checkpoint failed: "
+        << checkpointer->get_error() << endl;
+    }
+}
+
+lbool Solver::resume_from_checkpoint(const string& fname)
+{
+    assert(nVarsOuter() == 0 && "We can only resume into an empty solver");
+
+    SimpleInFile f;
+    f.start(fname);
+    if (f.get_uint64_t() != checkpoint_magic) {
+        std::cerr << "ERROR: '" << fname << "' is not a checkpoint of this version of the solver" << endl;
+        std::exit(-1);
+    }
+    const uint32_t num_vars = f.get_uint32_t();
+    if ((bool)f.get_uint32_t() != (occsimplifier != NULL)) {
+        std::cerr << "ERROR: checkpoint '" << fname << "' was made with different occurrence-based simplification settings" << endl;
+        std::exit(-1);
+    }
+
+    //Create all data structures, then overwrite them and trim them to size
+    new_vars(num_vars);
+    const lbool status = load_state(f);
+    if (f.get_uint64_t() != checkpoint_magic) {
+        std::cerr << "ERROR: checkpoint '" << fname << "' is corrupt" << endl;
+        std::exit(-1);
+    }
+    save_on_var_memory(nVars());
+    #ifdef USE_GAUSS
+    //Matrices are rebuilt from the XORs
+    xor_clauses_updated = true;
+    #endif
+    last_checkpoint_time = std::chrono::steady_clock::now();
+
+    if (conf.verbosity) {
+        cout << "c [checkpoint] resumed from '" << fname << "'"
+        << " vars: " << nVarsOutside()
+        << " irred cls: " << longIrredCls.size() + binTri.irredBins
+        << " conflicts: " << sumConflicts
+        << endl;
+    }
+    return status;
+}
+
 lbool Solver::load_solution_from_file(const string& fname)
 {
     //At this point, model is set up, we just need to fill the l_Undef in
@@ -4320,6 +4707,7 @@ void Solver::reset_vsids()
     for(auto& x: var_act_vsids) {
         x = ActAndOffset();
     }
+    order_heap_vsids.refresh_keys();
 }
 
 #ifdef STATS_NEEDED
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <utility>
 #include <string>
 #include <algorithm>
+#include <chrono>
 
 #include "constants.h"
 #include "solvertypes.h"
@@ -63,9 +64,11 @@ class SubsumeStrengthen;
 class SubsumeImplicit;
 class DataSync;
 class SharedData;
+class Portfolio;
 class ReduceDB;
 class InTree;
 class BreakID;
+class Checkpointer;
 
 struct SolveStats
 {
@@ -87,12 +90,22 @@ class Solver : public Searcher
         void new_external_var();
         void new_external_vars(size_t n);
         bool add_clause_outer(const vector<Lit>& lits, bool red = false);
+        bool add_clauses_outer(const int* lits, const size_t num_lits);
         bool add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs);
         void set_var_weight(Lit lit, double weight);
 
+        ///Hash of the irredundant clauses given so far, see NetSync
+        uint64_t get_input_hash() const
+        {
+            return input_hash;
+        }
+
         lbool solve_with_assumptions(const vector<Lit>* _assumptions, bool only_indep_solution);
         lbool simplify_with_assumptions(const vector<Lit>* _assumptions = NULL);
         void  set_shared_data(SharedData* shared_data);
+        void  set_portfolio_base_conf(const SolverConf& base);
+        void  set_shared_cls_db(const SharedClauseDB* db);
+        bool attach_shared_clauses();
 
         //drat for SAT problems
         void add_empty_cl_to_drat();
@@ -181,6 +194,12 @@ class Solver : public Searcher
         //State load/unload
         void save_state(const string& fname, const lbool status) const;
         lbool load_state(const string& fname);
+        void save_state(SimpleOutFile& f, const lbool status) const;
+        lbool load_state(SimpleInFile& f);
+        void save_checkpoint(const bool force = false);
+        lbool resume_from_checkpoint(const string& fname);
+        Checkpointer* checkpointer = NULL;
+        std::chrono::steady_clock::time_point last_checkpoint_time = std::chrono::steady_clock::now();
         template<typename A>
         void parse_v_line(A* in, const size_t lineNum);
         lbool load_solution_from_file(const string& fname);
@@ -309,6 +328,13 @@ class Solver : public Searcher
         void check_reconfigure();
         void reconfigure(int val);
         bool already_reconfigured = false;
+
+        //Adaptive portfolio
+        Portfolio* portfolio = NULL;
+        SolverConf portfolio_base_conf; ///<without the update_config() tuning
+        uint64_t portfolio_last_used = 0;
+        uint64_t portfolio_last_recv = 0;
+        void report_to_portfolio(const double search_time);
         long calc_num_confl_to_do_this_iter(const size_t iteration_num) const;
 
         vector<Lit> finalCl_tmp;
@@ -415,6 +441,16 @@ class Solver : public Searcher
         bool addClauseHelper(vector<Lit>& ps);
         bool addClauseInt(vector<Lit>& ps, const bool red = false);
 
+        //FNV-1a of the clauses given to the add_*_outer() functions
+        uint64_t input_hash = 14695981039346656037ULL;
+        void hash_input(const uint32_t word);
+
+        //Clauses of the SharedClauseDB
+        vector<Lit> shared_cls_tmp;
+        bool in_shared_cls_db(const vector<Lit>& lits);
+        bool shared_cl_numbering_ok(const uint32_t idx) const;
+        bool unshare_clauses();
+
         /////////////////
         // Debug
 
@@ -550,6 +586,14 @@ inline const vector<lbool>& Solver::get_model() const
     return model;
 }
 
+inline void Solver::hash_input(const uint32_t word)
+{
+    for(uint32_t i = 0; i < 4; i++) {
+        input_hash ^= (word >> (8*i)) & 0xff;
+        input_hash *= 1099511628211ULL;
+    }
+}
+
 inline const vector<Lit>& Solver::get_final_conflict() const
 {
     return conflict;
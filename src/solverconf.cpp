@@ -112,6 +112,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , do_blocking_restart(1)
         , blocking_restart_trail_hist_length(5000)
         , blocking_restart_multip(1.4)
+        , restart_reuse_trail(1)
         , local_glue_multiplier(0.80)
         , shortTermHistorySize (50)
         , lower_bound_for_blocking_restart(10000)
@@ -120,6 +121,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //branch strategy
         , branch_strategy_setup("maple1+maple2+vsids2+maple1+maple2+vsids1")
+        , order_heap_4ary(false)
 
         //Clause minimisation
         , doRecursiveMinim (true)
@@ -177,6 +179,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , varelim_sub_str_limit(600)
         , varElimRatioPerIter(1.60)
         , skip_some_bve_resolvents(true) //based on gates
+        , varelim_threads(1)
         , velim_resolvent_too_large(20)
         , var_linkin_limit_MB(1000)
 
@@ -244,9 +247,9 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         #ifdef FINAL_PREDICTOR
         //Predict system
-        , pred_conf_short("../../src/predict/predictor_short.json")
-        , pred_conf_long("../../src/predict/predictor_long.json")
-        , pred_conf_forever("../../src/predict/predictor_forever.json")
+        , pred_conf_short("../../src/predict/predictor_short.forest")
+        , pred_conf_long("../../src/predict/predictor_long.forest")
+        , pred_conf_forever("../../src/predict/predictor_forever.forest")
         , pred_keep_above(0.5f)
         #endif
 
@@ -323,6 +326,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxOccurRedMB    (600)
         , maxOccurRedLitLinkedM(50)
         , subsume_gothrough_multip(1.0)
+        , subsume_threads(1)
 
         //WalkSAT
         , doSLS(true)
@@ -389,10 +393,20 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , global_multiplier_multiplier_max(3)
         , var_and_mem_out_mult(1.0)
 
-        //Multi-thread, MPI
+        //Multi-thread, multi-process, MPI
         , sync_every_confl(20000)
+        , sync_long_max_size(6)
+        , sync_long_max_glue(3)
+        , sync_equivs(1)
+        , sync_phases(1)
+        , share_irred_db(0)
+        , portfolio_reconf_every(0)
+        , pin_threads(0)
         , thread_num(0)
 
+        //Cube-and-conquer
+        , cube_lookahead_vars(64)
+
         //misc
         , origSeed(0)
         , reconfigure_val(0)
@@ -400,6 +414,10 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , preprocess(0)
         , simulate_drat(false)
         , saved_state_file("savedstate.dat")
+
+        //Checkpointing
+        , checkpoint_every(1800)
+        , resume_from_checkpoint(false)
 {
     ratio_keep_clauses[clean_to_int(ClauseClean::glue)] = 0;
     ratio_keep_clauses[clean_to_int(ClauseClean::activity)] = 0.44;
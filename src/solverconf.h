@@ -276,6 +276,7 @@ class DLL_PUBLIC SolverConf
         int      do_blocking_restart;
         unsigned blocking_restart_trail_hist_length;
         double   blocking_restart_multip;
+        int      restart_reuse_trail; ///<Only backtrack to the first decision that would not be taken again
 
         double   local_glue_multiplier;
         unsigned  shortTermHistorySize; ///< Rolling avg. glue window size
@@ -285,6 +286,7 @@ class DLL_PUBLIC SolverConf
 
         //Branch strategy
         string branch_strategy_setup;
+        int order_heap_4ary; ///<4-ary branching heap with inline activities instead of the binary one
 
         //Clause minimisation
         int doRecursiveMinim;
@@ -343,6 +345,7 @@ class DLL_PUBLIC SolverConf
         long long varelim_sub_str_limit;
         double    varElimRatioPerIter;
         int      skip_some_bve_resolvents;
+        unsigned varelim_threads; ///<Threads for BVE. 1 is the classic sequential one, 0 is one per core
         int velim_resolvent_too_large; //-1 == no limit
         int var_linkin_limit_MB;
 
@@ -437,6 +440,7 @@ class DLL_PUBLIC SolverConf
         double maxOccurRedMB;
         double maxOccurRedLitLinkedM;
         double   subsume_gothrough_multip;
+        unsigned subsume_threads; ///<Threads for long-with-long subsumption and strengthening. 1 is sequential, 0 is one per available core
 
         //Walksat
         int doSLS;
@@ -505,10 +509,28 @@ class DLL_PUBLIC SolverConf
         double global_multiplier_multiplier_max;
         double var_and_mem_out_mult;
 
-        //Multi-thread, MPI
+        //Multi-thread, multi-process, MPI
         unsigned long long sync_every_confl;
+        unsigned sync_long_max_size;
+        unsigned sync_long_max_glue;
+        int sync_equivs; ///<share equivalent literals found by SCC between threads
+        int sync_phases; ///<share the phases of the longest trail between threads
+        ///Off by default. Threads >0 watch one shared copy of the long irred
+        ///clauses, and don't simplify. Thread 0 keeps its own copy so it can
+        ///still simplify, so the clauses are stored twice rather than once per
+        ///thread: it only saves memory from 3 threads up, and costs the other
+        ///threads all inprocessing. A thread that has to renumber copies the
+        ///whole shared DB, see Solver::unshare_clauses()
+        int share_irred_db;
+        double portfolio_reconf_every; ///<seconds between reconfiguring the weakest thread, 0 = never
+        string sync_net_listen; ///<share clauses with the processes that connect here, see NetSync
+        string sync_net_connect; ///<share clauses with the processes listening here, see NetSync
+        int pin_threads; ///<pin threads to CPUs, spread over the NUMA nodes
         unsigned thread_num;
 
+        //Cube-and-conquer
+        unsigned cube_lookahead_vars;
+
         //Misc
         unsigned origSeed;
         unsigned reconfigure_val;
@@ -519,6 +541,11 @@ class DLL_PUBLIC SolverConf
         std::string simplified_cnf;
         std::string solution_file;
         std::string saved_state_file;
+
+        //Checkpointing
+        std::string checkpoint_file;
+        double   checkpoint_every; ///<seconds of wall time between checkpoints
+        int      resume_from_checkpoint;
 };
 
 } //end namespace
@@ -23,6 +23,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 static const unsigned chunk_limit = 148576;
 
 #include <stdio.h>
+#include <string.h>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <limits>
@@ -64,6 +66,23 @@ struct CH {
     }
 };
 
+//A [pos, end) window into memory, e.g. into an mmap-ed file.
+//Unlike CH, it may contain '\0' and need not be terminated
+struct MemRange {
+    const char* pos;
+    const char* end;
+};
+
+struct MR {
+    static inline int read(void* buf, size_t num, size_t count, MemRange& f)
+    {
+        size_t toread = std::min<size_t>(num*count, f.end - f.pos);
+        memcpy(buf, f.pos, toread);
+        f.pos += toread;
+        return toread;
+    }
+};
+
 template<typename A, typename B>
 class StreamBuffer
 {
@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "solvertypes.h"
 #include "subsumeimplicit.h"
 #include <array>
+#include <atomic>
+#include <thread>
 
 //#define VERBOSE_DEBUG
 
@@ -60,6 +62,11 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
         , cl.abst
     );
 
+    return markirred_and_combine_stats(cl, ret);
+}
+
+uint32_t SubsumeStrengthen::markirred_and_combine_stats(Clause& cl, const Sub0Ret& ret)
+{
     //If irred is subsumed by redundant, make the redundant into irred
     if (cl.red()
         && ret.subsumedIrred
@@ -101,14 +108,22 @@ SubsumeStrengthen::Sub0Ret SubsumeStrengthen::subsume_and_unlink(
     , const cl_abst_type abs
     , const bool removeImplicit
 ) {
-    Sub0Ret ret;
-
     subs.clear();
     find_subsumed(offset, ps, abs, subs, removeImplicit);
+    return unlink_subsumed(subs);
+}
+
+SubsumeStrengthen::Sub0Ret SubsumeStrengthen::unlink_subsumed(
+    const vector<ClOffset>& subsumed
+) {
+    Sub0Ret ret;
 
     //Go through each clause that can be subsumed
-    for (const ClOffset offs: subs) {
+    for (const ClOffset offs: subsumed) {
         Clause *tmp = solver->cl_alloc.ptr(offs);
+        if (tmp->getRemoved()) {
+            continue;
+        }
         ret.stats = ClauseStats::combineStats(tmp->stats, ret.stats);
         #ifdef VERBOSE_DEBUG
         cout << "-> subsume removing:" << *tmp << endl;
@@ -133,7 +148,6 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
 {
     subs.clear();
     subsLits.clear();
-    Sub1Ret ret;
     Clause& cl = *solver->cl_alloc.ptr(offset);
     assert(!cl.getRemoved());
     assert(!cl.freed());
@@ -147,8 +161,18 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
         , cl.abst
         , subs
         , subsLits
+        , simplifier->limit_to_decrease
     );
 
+    return sub_str_with_found(offset);
+}
+
+//Subsumes or strengthens the clauses in subs/subsLits with the clause at
+//'offset', as found by findStrengthened()
+SubsumeStrengthen::Sub1Ret SubsumeStrengthen::sub_str_with_found(const ClOffset offset)
+{
+    Sub1Ret ret;
+    Clause& cl = *solver->cl_alloc.ptr(offset);
     for (size_t j = 0
         ; j < subs.size() && solver->okay()
         ; j++
@@ -248,8 +272,13 @@ void SubsumeStrengthen::backw_sub_long_with_long()
     randomise_clauses_order();
     const size_t max_go_through =
         solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size();
+    const uint32_t threads = num_threads();
 
-    while (*simplifier->limit_to_decrease > 0
+    if (threads > 1) {
+        subsumed = backw_sub_long_with_long_batched(threads, max_go_through, wenThrough);
+    }
+    while (threads == 1
+        && *simplifier->limit_to_decrease > 0
         && wenThrough < max_go_through
     ) {
         *simplifier->limit_to_decrease -= 3;
@@ -311,10 +340,17 @@ bool SubsumeStrengthen::backw_str_long_with_long()
     size_t wenThrough = 0;
     const int64_t orig_limit = *simplifier->limit_to_decrease;
     Sub1Ret ret;
+    size_t redone = 0;
 
     randomise_clauses_order();
-    while(*simplifier->limit_to_decrease > 0
-        && wenThrough < 1.5*(double)2*simplifier->clauses.size()
+    const size_t max_go_through = 1.5*(double)2*simplifier->clauses.size();
+    const uint32_t threads = num_threads();
+    if (threads > 1) {
+        redone = backw_str_long_with_long_batched(threads, max_go_through, wenThrough, ret);
+    }
+    while(threads == 1
+        && *simplifier->limit_to_decrease > 0
+        && wenThrough < max_go_through
         && solver->okay()
     ) {
         *simplifier->limit_to_decrease -= 10;
@@ -350,7 +386,11 @@ bool SubsumeStrengthen::backw_str_long_with_long()
         << " tried: " << wenThrough << "/" << simplifier->clauses.size()
         << " ("
         << stats_line_percent(wenThrough, simplifier->clauses.size())
-        << ") "
+        << ") ";
+        if (threads > 1) {
+            cout << "threads: " << threads << " redone: " << redone << " ";
+        }
+        cout
         << solver->conf.print_times(time_used, time_out, time_remain)
         << endl;
     }
@@ -372,6 +412,178 @@ bool SubsumeStrengthen::backw_str_long_with_long()
     return solver->okay();
 }
 
+//Clauses looked at by one round of parallel subsumption or strengthening.
+//Fixed, so the result does not depend on the number of threads.
+static const size_t sub_batch_size = 4096;
+
+uint32_t SubsumeStrengthen::num_threads() const
+{
+    if (solver->conf.subsume_threads == 0) {
+        return num_cpus_available();
+    }
+    return solver->conf.subsume_threads;
+}
+
+//Finds, in parallel, what the clauses at clauses[start...start+num] (wrapping
+//around) subsume or strengthen. Only reads the occurrence lists and the
+//clauses, and every worker writes into its own buffer.
+void SubsumeStrengthen::find_in_batch(
+    const bool str
+    , const size_t start
+    , const size_t num
+    , const uint32_t threads
+) {
+    batch.resize(num);
+    for(size_t i = 0; i < num; i++) {
+        batch[i].offset = simplifier->clauses[(start+i) % simplifier->clauses.size()];
+    }
+    if (workers.size() < threads) {
+        workers.resize(threads);
+    }
+    for(SubWorker& w: workers) {
+        w.subs.clear();
+        w.subsLits.clear();
+    }
+
+    std::atomic<size_t> at(0);
+    vector<std::thread> thds;
+    for(uint32_t i = 1; i < std::min<size_t>(threads, num); i++) {
+        thds.push_back(std::thread(
+            &SubsumeStrengthen::find_in_batch_worker, this, str, i, num, &at));
+    }
+    find_in_batch_worker(str, 0, num, &at);
+    for(std::thread& t: thds) {
+        t.join();
+    }
+}
+
+void SubsumeStrengthen::find_in_batch_worker(
+    const bool str
+    , const uint32_t worker
+    , const size_t num
+    , std::atomic<size_t>* at
+) {
+    SubWorker& w = workers[worker];
+    for(size_t i = (*at)++; i < num; i = (*at)++) {
+        SubCandidate& c = batch[i];
+        const Clause& cl = *solver->cl_alloc.ptr(c.offset);
+        c.worker = worker;
+        c.at = w.subs.size();
+        c.num = 0;
+        c.cost = 0;
+        c.size = cl.size();
+        if (cl.freed() || cl.getRemoved()) {
+            continue;
+        }
+
+        int64_t limit = 0;
+        if (str) {
+            findStrengthened(c.offset, cl, cl.abst, w.subs, w.subsLits, &limit);
+        } else {
+            find_subsumed(c.offset, cl, cl.abst, w.subs, false, &limit);
+        }
+        c.num = w.subs.size() - c.at;
+        c.cost = -limit;
+    }
+}
+
+//Same as the sequential loop, but finds the subsumed clauses of a whole batch
+//in parallel. Subsumption only removes clauses, so dropping the ones removed
+//since gives the same result as the sequential loop.
+size_t SubsumeStrengthen::backw_sub_long_with_long_batched(
+    const uint32_t threads
+    , const size_t max_go_through
+    , size_t& wenThrough
+) {
+    size_t subsumed = 0;
+    const size_t num = std::min(sub_batch_size, simplifier->clauses.size());
+    while (*simplifier->limit_to_decrease > 0
+        && wenThrough < max_go_through
+    ) {
+        find_in_batch(false, wenThrough+1, num, threads);
+        for(const SubCandidate& c: batch) {
+            if (*simplifier->limit_to_decrease <= 0
+                || wenThrough >= max_go_through
+            ) {
+                break;
+            }
+            *simplifier->limit_to_decrease -= 3;
+            wenThrough++;
+
+            Clause* cl = solver->cl_alloc.ptr(c.offset);
+            if (cl->freed() || cl->getRemoved())
+                continue;
+
+            *simplifier->limit_to_decrease -= 10 + c.cost;
+            const SubWorker& w = workers[c.worker];
+            subs.assign(w.subs.begin() + c.at, w.subs.begin() + c.at + c.num);
+            const Sub0Ret ret = unlink_subsumed(subs);
+            subsumed += markirred_and_combine_stats(*cl, ret);
+        }
+    }
+
+    return subsumed;
+}
+
+//Same as the sequential loop, but finds the candidates of a whole batch in
+//parallel. Strengthening changes clauses, so every candidate is re-checked
+//before use, and a clause that got strengthened itself is redone
+//sequentially. Returns the number of such clauses.
+size_t SubsumeStrengthen::backw_str_long_with_long_batched(
+    const uint32_t threads
+    , const size_t max_go_through
+    , size_t& wenThrough
+    , Sub1Ret& ret
+) {
+    size_t redone = 0;
+    const size_t num = std::min(sub_batch_size, simplifier->clauses.size());
+    while (*simplifier->limit_to_decrease > 0
+        && wenThrough < max_go_through
+        && solver->okay()
+    ) {
+        find_in_batch(true, wenThrough+1, num, threads);
+        for(const SubCandidate& c: batch) {
+            if (*simplifier->limit_to_decrease <= 0
+                || wenThrough >= max_go_through
+                || !solver->okay()
+            ) {
+                break;
+            }
+            *simplifier->limit_to_decrease -= 10;
+            wenThrough++;
+
+            Clause* cl = solver->cl_alloc.ptr(c.offset);
+            if (cl->freed() || cl->getRemoved())
+                continue;
+
+            if (cl->size() != c.size) {
+                redone++;
+                ret += strengthen_subsume_and_unlink_and_markirred(c.offset);
+                continue;
+            }
+
+            *simplifier->limit_to_decrease -= c.cost;
+            subs.clear();
+            subsLits.clear();
+            const SubWorker& w = workers[c.worker];
+            for(size_t i = c.at; i < c.at + c.num; i++) {
+                const Clause& cl2 = *solver->cl_alloc.ptr(w.subs[i]);
+                if (cl2.getRemoved() || cl->size() > cl2.size()) {
+                    continue;
+                }
+                const Lit l = subset1(*cl, cl2, simplifier->limit_to_decrease);
+                if (l != lit_Error) {
+                    subs.push_back(w.subs[i]);
+                    subsLits.push_back(l);
+                }
+            }
+            ret += sub_str_with_found(c.offset);
+        }
+    }
+
+    return redone;
+}
+
 /**
 @brief Helper function for findStrengthened
 
@@ -385,10 +597,11 @@ void inline SubsumeStrengthen::fillSubs(
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
     , const Lit lit
+    , int64_t* limit
 ) {
     Lit litSub;
     watch_subarray_const cs = solver->watches[lit];
-    *simplifier->limit_to_decrease -= (long)cs.size()*2+ 40;
+    *limit -= (long)cs.size()*2+ 40;
     for (const Watched *it = cs.begin(), *end = cs.end()
         ; it != end
         ; ++it
@@ -410,8 +623,8 @@ void inline SubsumeStrengthen::fillSubs(
             continue;
         }
 
-        *simplifier->limit_to_decrease -= (long)((cl.size() + cl2.size())/4);
-        litSub = subset1(cl, cl2);
+        *limit -= (long)((cl.size() + cl2.size())/4);
+        litSub = subset1(cl, cl2, limit);
         if (litSub != lit_Error) {
             out_subsumed.push_back(it->get_offset());
             out_lits.push_back(litSub);
@@ -440,6 +653,9 @@ Checks if:
 @param[out] out_subsumed The clauses that could be modified by ps
 @param[out] out_lits Defines HOW these clauses could be modified. By removing
 literal, or by subsumption (in this case, there is lit_Undef here)
+@param[in,out] limit Time budget to decrease
+
+Only reads the occurrence lists and clauses.
 */
 template<class T>
 void SubsumeStrengthen::findStrengthened(
@@ -448,6 +664,7 @@ void SubsumeStrengthen::findStrengthened(
     , const cl_abst_type abs
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
+    , int64_t* limit
 )
 {
     #ifdef VERBOSE_DEBUG
@@ -467,10 +684,10 @@ void SubsumeStrengthen::findStrengthened(
         }
     }
     assert(minVar != var_Undef);
-    *simplifier->limit_to_decrease -= (long)cl.size();
+    *limit -= (long)cl.size();
 
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true));
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false));
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true), limit);
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false), limit);
 }
 
 bool SubsumeStrengthen::handle_added_long_cl(
@@ -601,7 +818,7 @@ bool SubsumeStrengthen::subsetAbst(const cl_abst_type A, const cl_abst_type B)
 
 //A subsumes B (A <= B)
 template<class T1, class T2>
-bool SubsumeStrengthen::subset(const T1& A, const T2& B)
+bool SubsumeStrengthen::subset(const T1& A, const T2& B, int64_t* limit)
 {
     #ifdef MORE_DEUBUG
     cout << "A:" << A << endl;
@@ -642,7 +859,7 @@ bool SubsumeStrengthen::subset(const T1& A, const T2& B)
     ret = false;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    *limit -= (long)i2*4 + (long)i*4;
     return ret;
 }
 
@@ -660,7 +877,7 @@ clause B
 and returns the literal to remove if (2) is true
 */
 template<class T1, class T2>
-Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
+Lit SubsumeStrengthen::subset1(const T1& A, const T2& B, int64_t* limit)
 {
     Lit retLit = lit_Undef;
 
@@ -692,12 +909,12 @@ Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
     retLit = lit_Error;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    *limit -= (long)i2*4 + (long)i*4;
     return retLit;
 }
 
 template<class T>
-size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
+size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps, int64_t* limit) const
 {
     size_t min_i = 0;
     size_t min_num = solver->watches[ps[min_i]].size();
@@ -708,7 +925,7 @@ size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
             min_num = this_num;
         }
     }
-    *simplifier->limit_to_decrease -= (long)ps.size();
+    *limit -= (long)ps.size();
 
     return min_i;
 }
@@ -718,6 +935,9 @@ size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
 
 Only handles backward-subsumption. Uses occurrence lists
 @param[out] out_subsumed The set of clauses subsumed by the given
+@param[in,out] limit Time budget to decrease. NULL means the simplifier's
+
+Unless removeImplicit is set, only reads the occurrence lists and clauses.
 */
 template<class T> void SubsumeStrengthen::find_subsumed(
     const ClOffset offset //Will not match with index of the name value
@@ -725,7 +945,12 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     , const cl_abst_type abs //Abstraction of literals in clause
     , vector<ClOffset>& out_subsumed //List of clause indexes subsumed
     , bool removeImplicit
+    , int64_t* limit
 ) {
+    if (limit == NULL) {
+        limit = simplifier->limit_to_decrease;
+    }
+
     #ifdef VERBOSE_DEBUG
     cout << "find_subsumed: ";
     for (const Lit lit: ps) {
@@ -734,11 +959,11 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     cout << endl;
     #endif
 
-    const size_t smallest = find_smallest_watchlist_for_clause(ps);
+    const size_t smallest = find_smallest_watchlist_for_clause(ps, limit);
 
     //Go through the occur list of the literal that has the smallest occur list
     watch_subarray occ = solver->watches[ps[smallest]];
-    *simplifier->limit_to_decrease -= (long)occ.size()*8 + 40;
+    *limit -= (long)occ.size()*8 + 40;
 
     Watched* it = occ.begin();
     Watched* it2 = occ.begin();
@@ -766,14 +991,14 @@ template<class T> void SubsumeStrengthen::find_subsumed(
                     continue;
                 }
             }
+            *it2++ = *it;
         }
-        *it2++ = *it;
 
         if (!it->isClause()) {
             continue;
         }
 
-        *simplifier->limit_to_decrease -= 15;
+        *limit -= 15;
 
         if (it->get_offset() == offset
             || !subsetAbst(abs, it->getAbst())
@@ -787,15 +1012,17 @@ template<class T> void SubsumeStrengthen::find_subsumed(
         if (ps.size() > cl2.size() || cl2.getRemoved())
             continue;
 
-        *simplifier->limit_to_decrease -= 50;
-        if (subset(ps, cl2)) {
+        *limit -= 50;
+        if (subset(ps, cl2, limit)) {
             out_subsumed.push_back(offset2);
             #ifdef VERBOSE_DEBUG
             cout << "subsumed cl offset: " << offset2 << endl;
             #endif
         }
     }
-    occ.shrink(it-it2);
+    if (removeImplicit) {
+        occ.shrink(it-it2);
+    }
 }
 template void SubsumeStrengthen::find_subsumed(
     const ClOffset offset
@@ -803,6 +1030,7 @@ template void SubsumeStrengthen::find_subsumed(
     , const cl_abst_type abs //Abstraction of literals in clause
     , vector<ClOffset>& out_subsumed //List of clause indexes subsumed
     , bool removeImplicit
+    , int64_t* limit
 );
 
 size_t SubsumeStrengthen::mem_used() const
@@ -810,6 +1038,11 @@ size_t SubsumeStrengthen::mem_used() const
     size_t b = 0;
     b += subs.capacity()*sizeof(ClOffset);
     b += subsLits.capacity()*sizeof(Lit);
+    b += batch.capacity()*sizeof(SubCandidate);
+    for(const SubWorker& w: workers) {
+        b += w.subs.capacity()*sizeof(ClOffset);
+        b += w.subsLits.capacity()*sizeof(Lit);
+    }
 
     return b;
 }
@@ -875,6 +1108,7 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::backw_sub_str_long_with_implicit(
         , calcAbstraction(lits)
         , subs
         , subsLits
+        , simplifier->limit_to_decrease
     );
 
     Sub1Ret ret;
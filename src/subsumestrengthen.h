@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "clabstraction.h"
 #include "clause.h"
 #include <vector>
+#include <atomic>
 using std::vector;
 
 namespace CMSat {
@@ -102,6 +103,7 @@ public:
         , const cl_abst_type abs
         , vector<ClOffset>& out_subsumed
         , const bool removeImplicit = false
+        , int64_t* limit = NULL
     );
 
 private:
@@ -119,12 +121,38 @@ private:
         , const cl_abst_type abs
         , const bool removeImplicit = false
     );
+    Sub0Ret unlink_subsumed(const vector<ClOffset>& subsumed);
+    uint32_t markirred_and_combine_stats(Clause& cl, const Sub0Ret& ret);
+    Sub1Ret sub_str_with_found(const ClOffset offset);
+
+    //Parallel versions of backw_sub_long_with_long and backw_str_long_with_long
+    struct SubWorker {
+        vector<ClOffset> subs;
+        vector<Lit> subsLits;
+    };
+    struct SubCandidate {
+        ClOffset offset;
+        uint32_t size; //at the time it was looked at
+        uint32_t worker; //where its subs/subsLits are
+        uint32_t at;
+        uint32_t num;
+        int64_t cost;
+    };
+    vector<SubWorker> workers;
+    vector<SubCandidate> batch;
+    uint32_t num_threads() const;
+    void find_in_batch(bool str, size_t start, size_t num, uint32_t threads);
+    void find_in_batch_worker(bool str, uint32_t worker, size_t num, std::atomic<size_t>* at);
+    size_t backw_sub_long_with_long_batched(
+        uint32_t threads, size_t max_go_through, size_t& wenThrough);
+    size_t backw_str_long_with_long_batched(
+        uint32_t threads, size_t max_go_through, size_t& wenThrough, Sub1Ret& ret);
 
     void randomise_clauses_order();
     void remove_literal(ClOffset c, const Lit toRemoveLit);
 
     template<class T>
-    size_t find_smallest_watchlist_for_clause(const T& ps) const;
+    size_t find_smallest_watchlist_for_clause(const T& ps, int64_t* limit) const;
 
     template<class T>
     void findStrengthened(
@@ -133,6 +161,7 @@ private:
         , const cl_abst_type abs
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
+        , int64_t* limit
     );
 
     template<class T>
@@ -143,13 +172,14 @@ private:
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
         , const Lit lit
+        , int64_t* limit
     );
 
     template<class T1, class T2>
-    bool subset(const T1& A, const T2& B);
+    bool subset(const T1& A, const T2& B, int64_t* limit);
 
     template<class T1, class T2>
-    Lit subset1(const T1& A, const T2& B);
+    Lit subset1(const T1& A, const T2& B, int64_t* limit);
     bool subsetAbst(const cl_abst_type A, const cl_abst_type B);
 
     vector<ClOffset> subs;
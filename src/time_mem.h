@@ -191,4 +191,26 @@ static inline size_t memUsedTotal(double& vm_usage, std::string* max_mem_usage =
 }
 #endif
 
+//Number of CPUs this process may run on. Takes the affinity mask (taskset,
+//cgroup cpusets) into account where it's available.
+#if defined(__linux__)
+#include <sched.h>
+#include <thread>
+static inline unsigned num_cpus_available()
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0) {
+        return CPU_COUNT(&set);
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+#else
+#include <thread>
+static inline unsigned num_cpus_available()
+{
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+#endif
+
 #endif //TIME_MEM_H
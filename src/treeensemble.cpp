@@ -0,0 +1,187 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "treeensemble.h"
+
+#include <fstream>
+#include <iostream>
+#include <cmath>
+#include <cassert>
+#include <limits>
+#include <algorithm>
+
+using namespace CMSat;
+using std::cerr;
+using std::endl;
+
+void TreeEnsemble::load(const string& fname)
+{
+    std::ifstream in(fname);
+    if (!in) {
+        cerr << "ERROR: Cannot open tree ensemble file '" << fname << "'" << endl;
+        exit(-1);
+    }
+    if (!read(in)) {
+        cerr << "ERROR: File '" << fname << "' is not a valid tree ensemble" << endl;
+        exit(-1);
+    }
+}
+
+bool TreeEnsemble::read(std::istream& in)
+{
+    struct RawNode {
+        int64_t left;
+        int64_t right;
+        uint32_t feature;
+        float threshold;
+        uint32_t default_left;
+        float value;
+    };
+
+    nodes.clear();
+    roots.clear();
+    depths.clear();
+    max_feature = 0;
+
+    string word;
+    uint32_t num_trees;
+    if (!(in >> word >> num_trees >> base_score) || word != "forest") {
+        return false;
+    }
+
+    vector<RawNode> raw;
+    vector<uint32_t> new_at;
+    vector<uint32_t> depth;
+    vector<uint32_t> queue;
+    for(uint32_t t = 0; t < num_trees; t++) {
+        uint32_t num_nodes;
+        if (!(in >> word >> num_nodes) || word != "tree" || num_nodes == 0) {
+            return false;
+        }
+        raw.resize(num_nodes);
+        for(RawNode& r: raw) {
+            if (!(in >> r.left >> r.right >> r.feature
+                >> r.threshold >> r.default_left >> r.value)
+                || r.feature >= default_left_bit
+            ) {
+                return false;
+            }
+        }
+
+        //Breadth-first, so that children get consecutive places
+        const uint32_t base = nodes.size();
+        const uint32_t unset = std::numeric_limits<uint32_t>::max();
+        new_at.assign(num_nodes, unset);
+        depth.assign(num_nodes, 0);
+        queue.clear();
+        nodes.resize(base + num_nodes);
+        new_at[0] = 0;
+        queue.push_back(0);
+        uint32_t next = 1;
+        uint32_t tree_depth = 0;
+        for(size_t i = 0; i < queue.size(); i++) {
+            const uint32_t at = queue[i];
+            const RawNode& r = raw[at];
+            Node& n = nodes[base + new_at[at]];
+            if (r.left == -1) {
+                if (r.right != -1) {
+                    return false;
+                }
+                n.threshold = 0;
+                n.feature = 0;
+                n.left = base + new_at[at];
+                n.value = r.value;
+                continue;
+            }
+
+            if (r.left < 0 || r.left >= num_nodes
+                || r.right < 0 || r.right >= num_nodes
+                || new_at[r.left] != unset
+                || new_at[r.right] != unset
+                || r.left == r.right
+            ) {
+                return false;
+            }
+            new_at[r.left] = next;
+            new_at[r.right] = next+1;
+            depth[r.left] = depth[r.right] = depth[at]+1;
+            tree_depth = std::max(tree_depth, depth[at]+1);
+            queue.push_back(r.left);
+            queue.push_back(r.right);
+
+            n.threshold = r.threshold;
+            n.feature = r.feature | (r.default_left ? default_left_bit : 0);
+            n.left = base + next;
+            n.value = 0;
+            max_feature = std::max(max_feature, r.feature);
+            next += 2;
+        }
+        if (next != num_nodes) {
+            //Some nodes are not reachable from the root
+            return false;
+        }
+        roots.push_back(base);
+        depths.push_back(tree_depth);
+    }
+
+    return true;
+}
+
+void TreeEnsemble::predict(
+    const float* rows
+    , const uint32_t num_rows
+    , const uint32_t cols
+    , float* out
+) const {
+    assert(num_features() <= cols);
+    for(uint32_t r = 0; r < num_rows; r++) {
+        out[r] = base_score;
+    }
+
+    //One tree at a time over all rows, so the tree stays in cache
+    for(size_t t = 0; t < roots.size(); t++) {
+        const uint32_t root = roots[t];
+        const uint32_t depth = depths[t];
+        const float* row = rows;
+        for(uint32_t r = 0; r < num_rows; r++, row += cols) {
+            uint32_t at = root;
+            for(uint32_t d = 0; d < depth; d++) {
+                const Node& n = nodes[at];
+                const float x = row[n.feature & ~default_left_bit];
+                //isless() does not raise FE_INVALID on NaN, '<' does
+                const uint32_t go_right =
+                    (uint32_t)!std::isless(x, n.threshold)
+                    & ~((uint32_t)std::isnan(x) & (n.feature >> 31))
+                    & (uint32_t)(n.left != at);
+                at = n.left + go_right;
+            }
+            out[r] += nodes[at].value;
+        }
+    }
+}
+
+float TreeEnsemble::predict(const float* row) const
+{
+    float out;
+    predict(row, 1, num_features(), &out);
+    return out;
+}
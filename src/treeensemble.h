@@ -0,0 +1,99 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef TREEENSEMBLE_H
+#define TREEENSEMBLE_H
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <cstdint>
+
+using std::vector;
+using std::string;
+
+namespace CMSat {
+
+/**
+@brief Sum of regression trees, as trained by xgboost, without xgboost
+
+The model is read from the text format written by
+scripts/crystal/xgb_to_forest.py:
+
+    forest NUM_TREES BASE_SCORE
+    tree NUM_NODES
+    LEFT RIGHT FEATURE THRESHOLD DEFAULT_LEFT VALUE   (one line per node)
+
+Node 0 of a tree is its root, LEFT is -1 for leaves. A row goes left when
+its feature is below THRESHOLD, or when it is missing (NaN) and
+DEFAULT_LEFT is 1. The prediction is BASE_SCORE plus the VALUE of the leaf
+reached in every tree.
+
+Once read, the nodes of all trees are in a single array, with the two
+children of a node next to each other and leaves pointing to themselves.
+A row then takes exactly as many steps in a tree as the tree is deep, so
+walking it is a fixed number of loads and selects.
+*/
+class TreeEnsemble
+{
+    public:
+        ///Exits with an error if the file cannot be read
+        void load(const string& fname);
+        bool read(std::istream& in);
+
+        ///'rows' holds num_rows*cols floats, one row after the other
+        void predict(
+            const float* rows
+            , const uint32_t num_rows
+            , const uint32_t cols
+            , float* out
+        ) const;
+        float predict(const float* row) const;
+
+        uint32_t num_features() const
+        {
+            return max_feature+1;
+        }
+        size_t num_trees() const
+        {
+            return roots.size();
+        }
+
+    private:
+        struct Node {
+            float threshold;
+            uint32_t feature; ///<top bit set when missing goes left
+            uint32_t left; ///<right child is left+1, leaves point to themselves
+            float value;
+        };
+        static const uint32_t default_left_bit = 1U << 31;
+
+        vector<Node> nodes;
+        vector<uint32_t> roots;
+        vector<uint32_t> depths;
+        float base_score = 0;
+        uint32_t max_feature = 0;
+};
+
+}
+
+#endif //TREEENSEMBLE_H
@@ -30,11 +30,12 @@ THE SOFTWARE.
 namespace CMSat
 {
 
+//Level and reason of the assignment are not here, they are in
+//CNF::varLevel and CNF::varReason. Propagation and conflict analysis read
+//little else, and with these bulky structs in between they would each
+//need a separate cache line.
 struct VarData
 {
-    ///contains the decision level at which the assignment was made.
-    uint32_t level = 0;
-
     uint32_t maple_cancelled = 0;
     uint32_t maple_last_picked = 0;
     uint32_t maple_conflicted = 0;
@@ -42,9 +43,6 @@ struct VarData
     double weight = 0.5;
     #endif
 
-    //Reason this got propagated. NULL means decision/toplevel
-    PropBy reason = PropBy();
-
     lbool assumption = l_Undef;
 
     ///Whether var has been eliminated (var-elim, different component, etc.)
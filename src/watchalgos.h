@@ -50,6 +50,17 @@ static inline void removeWCl(watch_subarray ws, const ClOffset c)
     ws.shrink_(1);
 }
 
+static inline void removeWShared(watch_subarray ws, const uint32_t idx)
+{
+    Watched* i = ws.begin(), *end = ws.end();
+    for (; i != end && (!i->isShared() || i->get_shared_idx() != idx); i++);
+    assert(i != end);
+    Watched* j = i;
+    i++;
+    for (; i != end; j++, i++) *j = *i;
+    ws.shrink_(1);
+}
+
 //////////////////
 // BINARY Clause
 //////////////////
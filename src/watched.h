@@ -39,6 +39,7 @@ namespace CMSat {
 enum WatchType {
     watch_clause_t = 0
     , watch_binary_t = 1
+    , watch_shared_t = 2
     , watch_idx_t = 3
 };
 
@@ -91,6 +92,17 @@ class Watched {
         {
         }
 
+        /**
+        @brief Constructor for a clause of the SharedClauseDB
+        */
+        Watched(const WatchType t, const uint32_t shared_idx, const Lit blockedLit) :
+            data1(blockedLit.toInt())
+            , type(watch_shared_t)
+            , data2(shared_idx)
+        {
+            assert(t == watch_shared_t);
+        }
+
         /**
         @brief Constructor for an Index value
         */
@@ -106,7 +118,7 @@ class Watched {
         void setBlockedLit(const Lit blockedLit)
         {
             #ifdef DEBUG_WATCHED
-            assert(type == watch_clause_t);
+            assert(type == watch_clause_t || type == watch_shared_t);
             #endif
             data1 = blockedLit.toInt();
         }
@@ -132,6 +144,19 @@ class Watched {
             return (type == watch_idx_t);
         }
 
+        bool isShared() const
+        {
+            return (type == watch_shared_t);
+        }
+
+        uint32_t get_shared_idx() const
+        {
+            #ifdef DEBUG_WATCHED
+            assert(type == watch_shared_t);
+            #endif
+            return data2;
+        }
+
         uint32_t get_idx() const
         {
             #ifdef DEBUG_WATCHED
@@ -210,7 +235,7 @@ class Watched {
         Lit getBlockedLit() const
         {
             #ifdef DEBUG_WATCHED
-            assert(isClause());
+            assert(isClause() || isShared());
             #endif
             return Lit::toLit(data1);
         }
@@ -234,6 +259,17 @@ class Watched {
             return data2;
         }
 
+        /**
+        @brief Clause was moved in memory -- keeps the blocked literal
+        */
+        void set_offset(const ClOffset offset)
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isClause());
+            #endif
+            data2 = offset;
+        }
+
         bool operator==(const Watched& other) const
         {
             return data1 == other.data1 && data2 == other.data2 && type == other.type;
@@ -253,6 +289,10 @@ class Watched {
         ClOffset data2:EFFECTIVELY_USEABLE_BITS;
 };
 
+#ifndef LARGE_OFFSETS
+static_assert(sizeof(Watched) == 8, "Watched must stay 8 bytes with 32b clause offsets");
+#endif
+
 inline std::ostream& operator<<(std::ostream& os, const Watched& ws)
 {
 
@@ -264,6 +304,10 @@ inline std::ostream& operator<<(std::ostream& os, const Watched& ws)
         os << "Bin lit " << ws.lit2() << " (red: " << ws.red() << " )";
     }
 
+    if (ws.isShared()) {
+        os << "Shared clause " << ws.get_shared_idx();
+    }
+
     return os;
 }
 
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #define _XOR_H_
 
 #include "solvertypes.h"
+#include "simplefile.h"
 
 #include <vector>
 #include <set>
@@ -168,6 +169,22 @@ public:
     }
 
 
+    void save_to_file(SimpleOutFile& f) const
+    {
+        f.put_vector(vars);
+        f.put_vector(clash_vars);
+        f.put_uint32_t(rhs);
+        f.put_uint32_t(detached);
+    }
+
+    void load_from_file(SimpleInFile& f)
+    {
+        f.get_vector(vars);
+        f.get_vector(clash_vars);
+        rhs = f.get_uint32_t();
+        detached = f.get_uint32_t();
+    }
+
     bool rhs = false;
     vector<uint32_t> clash_vars;
     bool detached = false;
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "test_helper.h"
 using namespace CMSat;
 #include <vector>
+#include <limits>
 using std::vector;
 
 
@@ -110,6 +111,137 @@ TEST(normal_interface, solve_multi_thread)
     EXPECT_EQ(s.get_model()[1], l_True);
 }
 
+TEST(normal_interface, add_clauses_bulk)
+{
+    SATSolver s;
+    s.new_vars(3);
+    const vector<int> cls = {1, 2, 0, -1, 0, -2, 3, 0};
+    EXPECT_TRUE(s.add_clauses(cls.data(), cls.size()));
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ(s.get_model()[0], l_False);
+    EXPECT_EQ(s.get_model()[1], l_True);
+    EXPECT_EQ(s.get_model()[2], l_True);
+}
+
+TEST(normal_interface, add_clauses_bulk_unsat_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(3);
+    s.new_vars(2);
+    s.add_clause(str_to_cl("1, 2"));
+    const vector<int> cls = {-1, 2, 0, 1, -2, 0, -1, -2, 0};
+    s.add_clauses(cls.data(), cls.size());
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_False);
+}
+
+TEST(normal_interface, solve_cubes_sat)
+{
+    SATSolver s;
+    s.new_vars(4);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("-1, 3"));
+    s.add_clause(str_to_cl("-2, 4"));
+    s.add_clause(str_to_cl("-3, -4"));
+    lbool ret = s.solve_cubes(2);
+    EXPECT_EQ( ret, l_True);
+    const vector<lbool>& model = s.get_model();
+    EXPECT_TRUE(model[0] == l_True || model[1] == l_True);
+    EXPECT_TRUE(model[0] == l_False || model[2] == l_True);
+    EXPECT_TRUE(model[1] == l_False || model[3] == l_True);
+    EXPECT_TRUE(model[2] == l_False || model[3] == l_False);
+}
+
+TEST(normal_interface, solve_cubes_unsat_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(2);
+    s.new_vars(3);
+    s.add_clause(str_to_cl("1, 2, 3"));
+    s.add_clause(str_to_cl("1, 2, -3"));
+    s.add_clause(str_to_cl("1, -2, 3"));
+    s.add_clause(str_to_cl("1, -2, -3"));
+    s.add_clause(str_to_cl("-1, 2, 3"));
+    s.add_clause(str_to_cl("-1, 2, -3"));
+    s.add_clause(str_to_cl("-1, -2, 3"));
+    s.add_clause(str_to_cl("-1, -2, -3"));
+    lbool ret = s.solve_cubes(3);
+    EXPECT_EQ( ret, l_False);
+    EXPECT_EQ( s.okay(), false);
+}
+
+TEST(normal_interface, solve_cubes_assumps)
+{
+    SATSolver s;
+    s.new_vars(3);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("1, 3"));
+    vector<Lit> assumps = str_to_cl("-1, -2");
+    lbool ret = s.solve_cubes(2, &assumps);
+    EXPECT_EQ( ret, l_False);
+    EXPECT_EQ( s.okay(), true);
+
+    ret = s.solve_cubes(2);
+    EXPECT_EQ( ret, l_True);
+}
+
+TEST(normal_interface, solve_cubes_assumps_conflict)
+{
+    SATSolver s;
+    s.new_vars(4);
+    s.add_clause(str_to_cl("-1, 2, 3"));
+    s.add_clause(str_to_cl("-1, 2, -3"));
+    s.add_clause(str_to_cl("-1, -2, 3"));
+    s.add_clause(str_to_cl("-1, -2, -3"));
+    vector<Lit> assumps = str_to_cl("1, 4");
+    lbool ret = s.solve_cubes(2, &assumps);
+    EXPECT_EQ( ret, l_False);
+
+    //Only over the assumptions, never over the cubes
+    const vector<Lit>& conflict = s.get_conflict();
+    EXPECT_EQ( conflict, str_to_cl("-1"));
+}
+
+TEST(normal_interface, solve_cubes_unsat_clears_conflict)
+{
+    SATSolver s;
+    s.new_vars(3);
+    s.add_clause(str_to_cl("-1, 2"));
+    s.add_clause(str_to_cl("-1, -2"));
+    vector<Lit> assumps = str_to_cl("1");
+    lbool ret = s.solve(&assumps);
+    EXPECT_EQ( ret, l_False);
+    EXPECT_EQ( s.get_conflict(), str_to_cl("-1"));
+
+    s.add_clause(str_to_cl("1, 3"));
+    s.add_clause(str_to_cl("1, -3"));
+    ret = s.solve_cubes(2, &assumps);
+    EXPECT_EQ( ret, l_False);
+    EXPECT_TRUE( s.get_conflict().empty());
+    EXPECT_EQ( s.okay(), false);
+}
+
+TEST(normal_interface, solve_cubes_unsat_with_assumps_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(2);
+    s.new_vars(4);
+    s.add_clause(str_to_cl("1, 2, 3"));
+    s.add_clause(str_to_cl("1, 2, -3"));
+    s.add_clause(str_to_cl("1, -2, 3"));
+    s.add_clause(str_to_cl("1, -2, -3"));
+    s.add_clause(str_to_cl("-1, 2, 3"));
+    s.add_clause(str_to_cl("-1, 2, -3"));
+    s.add_clause(str_to_cl("-1, -2, 3"));
+    s.add_clause(str_to_cl("-1, -2, -3"));
+    vector<Lit> assumps = str_to_cl("4");
+    lbool ret = s.solve_cubes(3, &assumps);
+    EXPECT_EQ( ret, l_False);
+    EXPECT_TRUE( s.get_conflict().empty());
+    EXPECT_EQ( s.okay(), false);
+}
+
 TEST(normal_interface, logfile)
 {
     SATSolver* s = new SATSolver();
@@ -693,6 +825,28 @@ TEST(error_throw, multithread_drat)
         , std::runtime_error);
 }
 
+TEST(error_throw, add_clauses_unknown_var)
+{
+    SATSolver s;
+    s.new_vars(3);
+    const vector<int> cls = {1, -4, 0};
+
+    EXPECT_THROW({
+        s.add_clauses(cls.data(), cls.size());}
+        , std::runtime_error);
+}
+
+TEST(error_throw, add_clauses_int_min)
+{
+    SATSolver s;
+    s.new_vars(3);
+    const vector<int> cls = {1, std::numeric_limits<int>::min(), 0};
+
+    EXPECT_THROW({
+        s.add_clauses(cls.data(), cls.size());}
+        , std::runtime_error);
+}
+
 TEST(error_throw, toomany_vars)
 {
     SATSolver s;
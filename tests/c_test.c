@@ -57,6 +57,15 @@ int main(void) {
     assert(model.vals[1].x == L_FALSE);
     assert(model.vals[2].x == L_TRUE);
 
+    cmsat_free(solver);
+
+    solver = cmsat_new();
+    cmsat_new_vars(solver, 2);
+    const int cls[] = {1, 2, 0, -1, 0, -2, 0};
+    bool ok = cmsat_add_clauses(solver, cls, sizeof(cls)/sizeof(cls[0]));
+    assert(!ok);
+    ret = cmsat_solve(solver);
+    assert(ret.x == L_FALSE);
     cmsat_free(solver);
     return 0;
 }
@@ -0,0 +1,128 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include "src/solver.h"
+#include "src/solverconf.h"
+#include "src/MersenneTwister.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct CheckpointTest : public ::testing::Test {
+    CheckpointTest()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        std::remove(fname.c_str());
+
+        conf.verbosity = 0;
+        conf.doCompHandler = false;
+        conf.checkpoint_file = fname;
+
+        //Random 3-SAT at the threshold, far from solved in a few conflicts
+        MTRand rnd(1);
+        for(uint32_t i = 0; i < num_vars*426/100; i++) {
+            vector<Lit> cl;
+            for(uint32_t k = 0; k < 3; k++) {
+                cl.push_back(Lit(rnd.randInt(num_vars-1), rnd.randInt(1)));
+            }
+            cls.push_back(cl);
+        }
+    }
+    ~CheckpointTest()
+    {
+        std::remove(fname.c_str());
+    }
+
+    void add_all(Solver& s) const
+    {
+        s.new_vars(num_vars);
+        for(const vector<Lit>& cl: cls) {
+            s.add_clause_outer(cl);
+        }
+    }
+
+    bool satisfies(const vector<lbool>& model) const
+    {
+        for(const vector<Lit>& cl: cls) {
+            bool sat = false;
+            for(const Lit l: cl) {
+                sat |= (model[l.var()] ^ l.sign()) == l_True;
+            }
+            if (!sat) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const string fname = "checkpoint_test.ckpt";
+    const uint32_t num_vars = 150;
+    vector<vector<Lit> > cls;
+    SolverConf conf;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(CheckpointTest, saved_when_limit_stops)
+{
+    conf.max_confl = 100;
+    conf.checkpoint_every = 1e9;
+    Solver s(&conf, &must_inter);
+    add_all(s);
+    EXPECT_EQ(s.solve_with_assumptions(NULL, false), l_Undef);
+    EXPECT_TRUE(std::ifstream(fname).good());
+}
+
+TEST_F(CheckpointTest, resume_round_trip)
+{
+    lbool expected;
+    {
+        Solver s(&conf, &must_inter);
+        add_all(s);
+        expected = s.solve_with_assumptions(NULL, false);
+    }
+    EXPECT_NE(expected, l_Undef);
+
+    {
+        SolverConf c = conf;
+        c.max_confl = 100;
+        Solver s(&c, &must_inter);
+        add_all(s);
+        EXPECT_EQ(s.solve_with_assumptions(NULL, false), l_Undef);
+    }
+
+    conf.resume_from_checkpoint = true;
+    Solver s(&conf, &must_inter);
+    const lbool ret = s.solve_with_assumptions(NULL, false);
+    EXPECT_EQ(ret, expected);
+    EXPECT_EQ(s.nVarsOutside(), num_vars);
+    if (ret == l_True) {
+        EXPECT_TRUE(satisfies(s.get_model()));
+    }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -25,8 +25,11 @@ THE SOFTWARE.
 #include "cryptominisat5/cryptominisat.h"
 
 #include "src/heap.h"
+#include "src/orderheap.h"
 
 using CMSat::Heap;
+using CMSat::ActHeap;
+using CMSat::ActAndOffset;
 
 struct Comp
 {
@@ -94,6 +97,85 @@ TEST(heap_minim, inserted_inside)
     EXPECT_EQ(heap.inHeap(20), true);
 }
 
+TEST(act_heap, order)
+{
+    std::vector<ActAndOffset> acts(100);
+    for(size_t i = 0; i < acts.size(); i++) {
+        acts[i].act = (i*37) % 100;
+    }
+    ActHeap heap(acts);
+    for(size_t i = 0; i < acts.size(); i++) {
+        heap.insert(i);
+        EXPECT_EQ(heap.heap_property(), true);
+    }
+    for(int i = 99; i >= 0; i--) {
+        EXPECT_EQ(acts[heap.removeMin()].act, i);
+        EXPECT_EQ(heap.heap_property(), true);
+    }
+    EXPECT_EQ(heap.empty(), true);
+}
+
+TEST(act_heap, change_act)
+{
+    std::vector<ActAndOffset> acts(50);
+    std::vector<uint32_t> vars;
+    for(size_t i = 0; i < acts.size(); i++) {
+        acts[i].act = i;
+        vars.push_back(i);
+    }
+    ActHeap heap(acts);
+    heap.build(vars);
+    EXPECT_EQ(heap.heap_property(), true);
+    EXPECT_EQ(heap[0], 49);
+
+    acts[3].act = 100;
+    heap.decrease(3);
+    EXPECT_EQ(heap[0], 3);
+
+    acts[3].act = 0.5;
+    heap.increase(3);
+    EXPECT_EQ(heap[0], 49);
+    EXPECT_EQ(heap.heap_property(), true);
+
+    for(auto& a: acts) {
+        a.act *= 1e-10;
+    }
+    heap.refresh_keys();
+    acts[10].act = 1;
+    heap.update(10);
+    EXPECT_EQ(heap.removeMin(), 10);
+    EXPECT_EQ(heap.removeMin(), 49);
+    EXPECT_EQ(heap.inHeap(10), false);
+    EXPECT_EQ(heap.inHeap(48), true);
+}
+
+TEST(act_heap, grow_and_dealloc)
+{
+    std::vector<ActAndOffset> acts(1000);
+    std::vector<uint32_t> vars;
+    for(size_t i = 0; i < acts.size(); i++) {
+        acts[i].act = (i*7919) % 1000;
+        vars.push_back(i);
+    }
+    ActHeap heap(acts);
+    for(size_t i = 0; i < acts.size(); i++) {
+        heap.insert(i);
+    }
+    EXPECT_EQ(heap.size(), 1000U);
+    EXPECT_EQ(heap.heap_property(), true);
+
+    heap.clear(true);
+    EXPECT_EQ(heap.empty(), true);
+    EXPECT_EQ(heap.inHeap(5), false);
+
+    heap.build(vars);
+    EXPECT_EQ(heap.heap_property(), true);
+    for(int i = 999; i >= 0; i--) {
+        EXPECT_EQ(acts[heap.removeMin()].act, i);
+    }
+    EXPECT_EQ(heap.empty(), true);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -21,6 +21,7 @@ THE SOFTWARE.
 ***********************************************/
 
 #include "gtest/gtest.h"
+#include <cstdlib>
 extern "C" {
 #include "src/ipasir.h"
 }
@@ -395,6 +396,81 @@ TEST(ipasir_interface, ipasir_val)
     EXPECT_EQ(ipasir_val(s, 8), 8);
 }
 
+//n+1 pigeons into n holes. Var of pigeon p in hole h is p*n+h+1
+static void add_php(void* s, const int n)
+{
+    for(int p = 0; p < n+1; p++) {
+        for(int h = 0; h < n; h++) {
+            ipasir_add(s, p*n+h+1);
+        }
+        ipasir_add(s, 0);
+    }
+    for(int h = 0; h < n; h++) {
+        for(int p1 = 0; p1 < n+1; p1++) {
+            for(int p2 = p1+1; p2 < n+1; p2++) {
+                ipasir_add(s, -(p1*n+h+1));
+                ipasir_add(s, -(p2*n+h+1));
+                ipasir_add(s, 0);
+            }
+        }
+    }
+}
+
+static int terminate_after_calls(void* state)
+{
+    int* calls = (int*)state;
+    (*calls)++;
+    return *calls >= 2;
+}
+
+TEST(ipasir_interface, terminate)
+{
+    void* s = ipasir_init();
+    add_php(s, 12);
+    int calls = 0;
+    ipasir_set_terminate(s, &calls, terminate_after_calls);
+    int ret = ipasir_solve(s);
+    EXPECT_EQ(ret, 0);
+    EXPECT_GE(calls, 2);
+    ipasir_release(s);
+}
+
+struct LearnState {
+    int max_len = 0;
+    int max_var = 0;
+    int num = 0;
+    bool ok = true;
+};
+
+static void learn_check(void* state, int* clause)
+{
+    LearnState* st = (LearnState*)state;
+    int len = 0;
+    for(; clause[len] != 0; len++) {
+        if (std::abs(clause[len]) > st->max_var) {
+            st->ok = false;
+        }
+    }
+    if (len == 0 || len > st->max_len) {
+        st->ok = false;
+    }
+    st->num++;
+}
+
+TEST(ipasir_interface, learn)
+{
+    void* s = ipasir_init();
+    add_php(s, 6);
+    LearnState st;
+    st.max_len = 4;
+    st.max_var = 7*6;
+    ipasir_set_learn(s, &st, st.max_len, learn_check);
+    int ret = ipasir_solve(s);
+    EXPECT_EQ(ret, 20);
+    EXPECT_GT(st.num, 0);
+    EXPECT_TRUE(st.ok);
+    ipasir_release(s);
+}
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
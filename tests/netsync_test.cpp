@@ -0,0 +1,131 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <unistd.h>
+#include "src/netsync.h"
+#include "test_helper.h"
+
+using namespace CMSat;
+
+//Moves data until 'to' got 'num' clauses, or it gives up
+static vector<vector<Lit> > get_all(
+    vector<NetSync*> all
+    , NetSync& to
+    , const size_t num
+) {
+    vector<vector<Lit> > ret;
+    vector<Lit> lits;
+    uint32_t glue;
+    for(int i = 0; i < 1000 && ret.size() < num; i++) {
+        for(NetSync* n: all) {
+            n->exchange();
+        }
+        while(to.get(lits, glue)) {
+            ret.push_back(lits);
+        }
+        usleep(1000);
+    }
+    return ret;
+}
+
+TEST(netsync_test, tcp_loopback)
+{
+    NetSync serve("tcp:127.0.0.1:0", true, 10, 1, 0);
+    const uint16_t port = serve.get_listen_port();
+    ASSERT_NE(port, 0);
+
+    NetSync conn("tcp:127.0.0.1:" + std::to_string(port), false, 10, 1, 0);
+    conn.send(str_to_cl("1, -2, 3"), 2);
+    conn.send(str_to_cl("-4"), 1);
+
+    vector<vector<Lit> > got = get_all({&serve, &conn}, serve, 2);
+    ASSERT_EQ(got.size(), 2u);
+    EXPECT_EQ(got[0], str_to_cl("1, -2, 3"));
+    EXPECT_EQ(got[1], str_to_cl("-4"));
+    EXPECT_EQ(serve.num_peers(), 1u);
+
+    serve.send(str_to_cl("5, 6"), 1);
+    got = get_all({&serve, &conn}, conn, 1);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0], str_to_cl("5, 6"));
+}
+
+TEST(netsync_test, unix_forwards)
+{
+    const std::string addr = "unix:/tmp/cms-netsync-test-" + std::to_string(getpid());
+    NetSync serve(addr, true, 10, 1, 0);
+    NetSync conn1(addr, false, 10, 1, 0);
+    NetSync conn2(addr, false, 10, 1, 0);
+
+    conn1.send(str_to_cl("1, 2, 3, 4"), 3);
+    vector<vector<Lit> > got = get_all({&serve, &conn1, &conn2}, conn2, 1);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0], str_to_cl("1, 2, 3, 4"));
+
+    //Not sent back to where it came from
+    got = get_all({&serve, &conn1, &conn2}, conn1, 1);
+    EXPECT_EQ(got.size(), 0u);
+}
+
+TEST(netsync_test, different_num_vars_dropped)
+{
+    NetSync serve("tcp:127.0.0.1:0", true, 10, 1, 0);
+    NetSync conn(
+        "tcp:127.0.0.1:" + std::to_string(serve.get_listen_port()), false, 11, 1, 0);
+    conn.send(str_to_cl("1, 2"), 1);
+
+    vector<vector<Lit> > got = get_all({&serve, &conn}, serve, 1);
+    EXPECT_EQ(got.size(), 0u);
+    EXPECT_EQ(serve.num_peers(), 0u);
+}
+
+TEST(netsync_test, different_formula_dropped)
+{
+    NetSync serve("tcp:127.0.0.1:0", true, 10, 1, 0);
+    NetSync conn(
+        "tcp:127.0.0.1:" + std::to_string(serve.get_listen_port()), false, 10, 2, 0);
+    conn.send(str_to_cl("1, 2"), 1);
+
+    vector<vector<Lit> > got = get_all({&serve, &conn}, serve, 1);
+    EXPECT_EQ(got.size(), 0u);
+    EXPECT_EQ(serve.num_peers(), 0u);
+}
+
+TEST(netsync_test, tcp_without_host)
+{
+    NetSync serve("tcp:0", true, 10, 1, 0);
+    const uint16_t port = serve.get_listen_port();
+    ASSERT_NE(port, 0);
+
+    NetSync conn("tcp:127.0.0.1:" + std::to_string(port), false, 10, 1, 0);
+    conn.send(str_to_cl("1, 2"), 1);
+    vector<vector<Lit> > got = get_all({&serve, &conn}, serve, 1);
+    ASSERT_EQ(got.size(), 1u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
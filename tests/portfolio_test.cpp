@@ -0,0 +1,104 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/portfolio.h"
+
+using CMSat::Portfolio;
+using CMSat::ThreadScore;
+
+static ThreadScore mk_score(double x)
+{
+    ThreadScore s;
+    s.confl_per_sec = x;
+    s.good_learnt_ratio = x;
+    s.trail_ratio = x;
+    s.imported_use = x;
+    return s;
+}
+
+TEST(portfolio, waits_for_all_threads)
+{
+    Portfolio p(3);
+    EXPECT_EQ(p.report(1, mk_score(0), 0), 0);
+    EXPECT_EQ(p.report(2, mk_score(5), 0), 0);
+    EXPECT_EQ(p.get_num_reconfs(), 0U);
+}
+
+TEST(portfolio, weakest_reconfigured)
+{
+    Portfolio p(3);
+    p.report(0, mk_score(5), 0);
+    p.report(2, mk_score(5), 0);
+    const int val = p.report(1, mk_score(0), 0);
+    EXPECT_NE(val, 0);
+    EXPECT_EQ(p.get_num_reconfs(), 1U);
+}
+
+TEST(portfolio, pending_until_next_report)
+{
+    Portfolio p(3);
+    p.report(0, mk_score(5), 0);
+    p.report(1, mk_score(0), 0);
+    EXPECT_EQ(p.report(2, mk_score(5), 0), 0);
+    EXPECT_EQ(p.get_num_reconfs(), 1U);
+    EXPECT_NE(p.report(1, mk_score(0), 0), 0);
+    EXPECT_EQ(p.report(1, mk_score(0), 0), 0);
+}
+
+TEST(portfolio, thread_zero_kept)
+{
+    Portfolio p(3);
+    p.report(1, mk_score(5), 0);
+    p.report(2, mk_score(4), 0);
+    EXPECT_EQ(p.report(0, mk_score(0), 0), 0);
+    EXPECT_EQ(p.get_num_reconfs(), 0U);
+}
+
+TEST(portfolio, different_configs)
+{
+    Portfolio p(3);
+    p.report(0, mk_score(5), 0);
+    p.report(2, mk_score(1), 0);
+    const int val1 = p.report(1, mk_score(0), 0);
+    EXPECT_NE(val1, 0);
+
+    p.report(0, mk_score(5), 0);
+    p.report(1, mk_score(1), 0);
+    const int val2 = p.report(2, mk_score(0), 0);
+    EXPECT_NE(val2, 0);
+    EXPECT_NE(val1, val2);
+}
+
+TEST(portfolio, period_respected)
+{
+    Portfolio p(2);
+    p.report(0, mk_score(5), 1000);
+    EXPECT_EQ(p.report(1, mk_score(0), 1000), 0);
+    EXPECT_EQ(p.get_num_reconfs(), 0U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/treeensemble.h"
+#include <sstream>
+#include <limits>
+
+using CMSat::TreeEnsemble;
+
+static const float nan_val = std::numeric_limits<float>::quiet_NaN();
+
+//x0 < 2: (x1 < 5: 1, else 2, missing right), else 3. Missing x0 goes left
+static const char* one_tree =
+    "forest 1 0.5\n"
+    "tree 5\n"
+    "1 2 0 2 1 0\n"
+    "3 4 1 5 0 0\n"
+    "-1 -1 0 0 0 3\n"
+    "-1 -1 0 0 0 1\n"
+    "-1 -1 0 0 0 2\n";
+
+static TreeEnsemble read_str(const char* str)
+{
+    TreeEnsemble t;
+    std::istringstream in(str);
+    EXPECT_TRUE(t.read(in));
+    return t;
+}
+
+TEST(treeensemble, one_tree)
+{
+    TreeEnsemble t = read_str(one_tree);
+    EXPECT_EQ(t.num_trees(), 1U);
+    EXPECT_EQ(t.num_features(), 2U);
+
+    float row[2] = {1, 4};
+    EXPECT_FLOAT_EQ(t.predict(row), 1.5f);
+    row[1] = 5;
+    EXPECT_FLOAT_EQ(t.predict(row), 2.5f);
+    row[0] = 2;
+    EXPECT_FLOAT_EQ(t.predict(row), 3.5f);
+}
+
+TEST(treeensemble, missing)
+{
+    TreeEnsemble t = read_str(one_tree);
+    float row[2] = {nan_val, 4};
+    EXPECT_FLOAT_EQ(t.predict(row), 1.5f);
+    row[1] = nan_val;
+    EXPECT_FLOAT_EQ(t.predict(row), 2.5f);
+}
+
+TEST(treeensemble, children_in_any_order)
+{
+    //Same tree as one_tree, nodes numbered depth-first, leaves first
+    TreeEnsemble t = read_str(
+        "forest 1 0.5\n"
+        "tree 5\n"
+        "4 1 0 2 1 0\n"
+        "-1 -1 0 0 0 3\n"
+        "-1 -1 0 0 0 1\n"
+        "-1 -1 0 0 0 2\n"
+        "2 3 1 5 0 0\n");
+
+    float row[2] = {1, 4};
+    EXPECT_FLOAT_EQ(t.predict(row), 1.5f);
+    row[1] = 5;
+    EXPECT_FLOAT_EQ(t.predict(row), 2.5f);
+    row[0] = 2;
+    EXPECT_FLOAT_EQ(t.predict(row), 3.5f);
+}
+
+TEST(treeensemble, trees_summed_batch)
+{
+    TreeEnsemble t = read_str(
+        "forest 3 0\n"
+        "tree 5\n"
+        "1 2 0 2 1 0\n"
+        "3 4 1 5 0 0\n"
+        "-1 -1 0 0 0 3\n"
+        "-1 -1 0 0 0 1\n"
+        "-1 -1 0 0 0 2\n"
+        "tree 1\n"
+        "-1 -1 0 0 0 10\n"
+        "tree 3\n"
+        "1 2 2 0 0 0\n"
+        "-1 -1 0 0 0 100\n"
+        "-1 -1 0 0 0 200\n");
+    EXPECT_EQ(t.num_features(), 3U);
+
+    const float rows[4*3] = {
+        1, 4, -1,
+        1, 5, 1,
+        3, 0, nan_val,
+        nan_val, nan_val, 0
+    };
+    float out[4];
+    t.predict(rows, 4, 3, out);
+    EXPECT_FLOAT_EQ(out[0], 111);
+    EXPECT_FLOAT_EQ(out[1], 212);
+    EXPECT_FLOAT_EQ(out[2], 213);
+    EXPECT_FLOAT_EQ(out[3], 212);
+    for(uint32_t r = 0; r < 4; r++) {
+        EXPECT_FLOAT_EQ(t.predict(rows + r*3), out[r]);
+    }
+}
+
+TEST(treeensemble, bad_models)
+{
+    const char* bad[] = {
+        "",
+        "forest 1 0\n",
+        "forest 1 0\ntree 0\n",
+        "forest 1 0\ntree 3\n1 2 0 0 0 0\n-1 -1 0 0 0 1\n",
+        //child out of range
+        "forest 1 0\ntree 3\n1 3 0 0 0 0\n-1 -1 0 0 0 1\n-1 -1 0 0 0 1\n",
+        //child used twice
+        "forest 1 0\ntree 3\n1 1 0 0 0 0\n-1 -1 0 0 0 1\n-1 -1 0 0 0 1\n",
+        //node not reachable
+        "forest 1 0\ntree 2\n-1 -1 0 0 0 1\n-1 -1 0 0 0 1\n",
+        //loop to the root
+        "forest 1 0\ntree 3\n1 0 0 0 0 0\n-1 -1 0 0 0 1\n-1 -1 0 0 0 1\n",
+    };
+    for(const char* str: bad) {
+        TreeEnsemble t;
+        std::istringstream in(str);
+        EXPECT_FALSE(t.read(in)) << str;
+    }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}